@@ -0,0 +1,60 @@
+#include <iostream>
+#include <string>
+
+// Include the Quoneq FTP session and network utility headers.
+#include <quoneq/ftp_session.hpp>
+#include <quoneq/net.hpp>
+
+// Define the base FTP URL for the FTP server.
+// In this example, the FTP server is located at 192.168.100.122.
+#define FTP_URL "ftp://192.168.100.122"
+
+// Forward declaration of the net_cleanup function.
+void net_cleanup();
+
+int main() {
+    // Print a message indicating that network initialization is starting.
+    std::cout << "Initializing Quoneq..." << std::endl;
+
+    // Initialize network resources required by Quoneq.
+    quoneq_net::init();
+
+    {
+        // The session logs in once and keeps its control connection open,
+        // so the following operations do not reconnect to the server.
+        quoneq_ftp_session session(FTP_URL);
+
+        // Upload the local file "README.md" to the server.
+        auto response = session.upload("/README.md", "README.md");
+        if(!response->errorMessage.empty())
+            std::cout << "Error Message:" <<
+                std::endl << response->errorMessage <<
+                std::endl;
+
+        // List the names in the root directory of the server.
+        auto listing = session.list("/");
+        for(const auto &name : listing->list)
+            std::cout << name << std::endl;
+
+        // Read the uploaded file back over the same connection.
+        auto readResponse = session.read("/README.md");
+        std::cout << "File size: " <<
+            readResponse->content.size() << std::endl;
+
+        // Report how many control connections the operations needed.
+        std::cout << "Connections: " <<
+            session.connection_count() << "/" <<
+            session.operation_count() << std::endl;
+    }
+
+    // Clean up network resources before the program exits.
+    net_cleanup();
+    return 0;
+}
+
+// This function calls quoneq_net::cleanup() to release any allocated network resources,
+// and then prints a confirmation message to the console.
+void net_cleanup() {
+    quoneq_net::cleanup();
+    std::cout << "Cleaned up Quoneq network." << std::endl;
+}
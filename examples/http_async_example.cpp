@@ -0,0 +1,55 @@
+#include <future>
+#include <iostream>
+#include <vector>
+
+#include <quoneq/http.hpp>          // For making HTTP requests
+#include <quoneq/net.hpp>           // For initializing and cleaning up network resources
+
+// Define a constant for the Cat Fact API URL
+#define CAT_FACT "https://catfact.ninja/fact"
+
+// Forward declaration for the network cleanup function
+void net_cleanup();
+
+int main() {
+    // Inform the user that the network subsystem is being initialized
+    std::cout << "Initializing Quoneq..." << std::endl;
+
+    // Initialize the network resources (e.g., set up any necessary libraries or configurations)
+    quoneq_net::init();
+
+    // Issue a few GET requests without blocking; each returns immediately with a
+    // future that the internal event loop completes once the transfer finishes
+    std::vector<std::future<std::unique_ptr<quoneq_http_response>>> pending;
+    for(int i = 0; i < 3; i++)
+        pending.push_back(quoneq_http_client::get_async(CAT_FACT));
+
+    // The calling thread is free to do other work here
+    std::cout << "Requests issued, waiting for responses..." << std::endl;
+
+    for(auto& future : pending) {
+        // Block only when the result is actually needed
+        auto response = future.get();
+
+        // Output the HTTP status code received from the server
+        std::cout << "Response status: " << response->status << std::endl;
+
+        // If the response status is not 200 (OK), print the error message of the request
+        if(response->status != 200)
+            std::cout << "Error Message:" <<
+                std::endl << response->errorMessage <<
+                std::endl;
+        else std::cout << response->content << std::endl;
+    }
+
+    // Clean up network resources (this also stops the event loop thread)
+    net_cleanup();
+    return 0;
+}
+
+// This function calls quoneq_net::cleanup() to release any resources or settings
+// that were initialized by quoneq_net::init() earlier.
+void net_cleanup() {
+    quoneq_net::cleanup();
+    std::cout << "Cleaned up Quoneq network." << std::endl;
+}
@@ -0,0 +1,152 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>              // For inet_pton()
+#include <netinet/in.h>             // For sockaddr_in
+#include <sys/socket.h>             // For the loopback server socket
+#include <unistd.h>                 // For read(), write() and close()
+
+#include <quoneq/http_session.hpp>  // For performing HTTP requests over a persistent session
+#include <quoneq/net.hpp>           // For initializing and cleaning up network resources
+
+// Number of requests timed, unless given as the first argument
+#define DEFAULT_REQUESTS 20000
+
+// Number of header lines in every response, unless given as the second argument
+#define DEFAULT_HEADER_LINES 16
+
+// Builds the response the loopback server answers every request with: a status
+// line, the requested number of typical header lines and an empty body
+std::string build_response(size_t header_lines) {
+    static const char* const fields[] = {
+        "Date: Fri, 16 Oct 2026 01:50:40 GMT",
+        "Server: quoneq-benchmark",
+        "Content-Type: application/json; charset=utf-8",
+        "Cache-Control: private, max-age=0, must-revalidate",
+        "ETag: \"5d8c72a5edda8d6a\"",
+        "Last-Modified: Thu, 15 Oct 2026 22:13:05 GMT",
+        "Vary: Accept-Encoding, Origin",
+        "X-Content-Type-Options: nosniff",
+        "X-Frame-Options: DENY",
+        "Strict-Transport-Security: max-age=31536000; includeSubDomains",
+        "Access-Control-Allow-Origin: *",
+        "Set-Cookie: session=8f14e45fceea167a5a36dedd4bea2543; Path=/; HttpOnly",
+        "Set-Cookie: theme=dark; Path=/",
+        "X-Request-Id: 3f2b9c1e-7d4a-4e1b-9b8f-2a6c5d4e3f21",
+        "Via: 1.1 cache-1"
+    };
+    const size_t field_count = sizeof(fields) / sizeof(fields[0]);
+
+    // Content-Length and Connection count towards the requested lines
+    std::string response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: keep-alive\r\n";
+    for(size_t i = 2; i < header_lines; i++)
+        response += std::string(fields[i % field_count]) + "\r\n";
+
+    return response + "\r\n";
+}
+
+// Answers every request on every accepted connection with the canned response,
+// until the listening socket is shut down
+void serve(int listener, const std::string& response) {
+    while(true) {
+        int client = accept(listener, nullptr, nullptr);
+        if(client < 0)
+            return;
+
+        std::string received;
+        char buffer[4096];
+
+        while(true) {
+            ssize_t count = read(client, buffer, sizeof(buffer));
+            if(count <= 0)
+                break;
+
+            received.append(buffer, static_cast<size_t>(count));
+
+            // Requests carry no body, so each blank line ends one of them
+            size_t end = 0;
+            while((end = received.find("\r\n\r\n")) != std::string::npos) {
+                received.erase(0, end + 4);
+
+                if(write(client, response.data(), response.size()) < 0)
+                    break;
+            }
+        }
+
+        close(client);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t requests = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : DEFAULT_REQUESTS;
+    size_t header_lines = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : DEFAULT_HEADER_LINES;
+
+    // Listen on an ephemeral loopback port, so that the measurement does not
+    // depend on any external server or network
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+
+    socklen_t address_length = sizeof(address);
+    if(listener < 0 ||
+        bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, 4) != 0 ||
+        getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_length) != 0) {
+        std::cout << "Unable to start the loopback server." << std::endl;
+        return 1;
+    }
+
+    std::thread server(serve, listener, build_response(header_lines));
+    std::string url = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port)) + "/";
+
+    quoneq_net::init();
+
+    // Scope the session so that its connection is closed before the network cleanup
+    {
+        quoneq_http_session session;
+
+        // Warm up the connection and the allocator before timing
+        for(size_t i = 0; i < 100; i++)
+            session.get(url);
+
+        size_t parsed = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for(size_t i = 0; i < requests; i++) {
+            auto response = session.get(url);
+
+            if(response->status != 200) {
+                std::cout << "Request failed: " << response->errorMessage << std::endl;
+                break;
+            }
+
+            parsed += response->header.size();
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // Each request is a full loopback round trip, so the header parsing
+        // share of the total shows up as the difference between two builds
+        std::cout << "Requests:           " << requests << std::endl;
+        std::cout << "Header lines each:  " << header_lines << std::endl;
+        std::cout << "Header fields kept: " << parsed << std::endl;
+        std::cout << "Elapsed:            " << elapsed.count() << " s" << std::endl;
+        std::cout << "Requests/sec:       " <<
+            static_cast<double>(requests) / elapsed.count() << std::endl;
+        std::cout << "Header lines/sec:   " <<
+            static_cast<double>(requests * header_lines) / elapsed.count() << std::endl;
+    }
+
+    quoneq_net::cleanup();
+
+    shutdown(listener, SHUT_RDWR);
+    close(listener);
+    server.join();
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+#include <vector>
+
+#include <quoneq/http_multi.hpp>    // For performing concurrent HTTP requests via curl_multi
+#include <quoneq/net.hpp>           // For initializing and cleaning up network resources
+
+// Define a constant for the Cat Fact API URL
+#define CAT_FACT "https://catfact.ninja/fact"
+
+// Forward declaration for the network cleanup function
+void net_cleanup();
+
+int main() {
+    // Inform the user that the network subsystem is being initialized
+    std::cout << "Initializing Quoneq..." << std::endl;
+
+    // Initialize the network resources (e.g., set up any necessary libraries or configurations)
+    quoneq_net::init();
+
+    // Scope the engine so that its connections are closed before the network cleanup
+    {
+        // Allow up to 8 transfers in flight, with at most 2 connections per host
+        quoneq_http_multi multi(8, 2L);
+
+        // Describe a batch of GET requests to the Cat Fact API
+        std::vector<quoneq_http_request> requests(5);
+        for(auto& request : requests)
+            request.url = CAT_FACT;
+
+        // Perform the whole batch from a single event loop on this thread;
+        // the responses come back in the same order as the requests
+        auto responses = multi.perform(requests);
+
+        for(const auto& response : responses) {
+            // Output the HTTP status code received from the server
+            std::cout << "Response status: " << response->status << std::endl;
+
+            // If the response status is not 200 (OK), print the error message of the request
+            if(response->status != 200)
+                std::cout << "Error Message:" <<
+                    std::endl << response->errorMessage <<
+                    std::endl;
+            else std::cout << response->content << std::endl;
+        }
+    }
+
+    // Clean up network resources (release any allocated resources, etc.)
+    net_cleanup();
+    return 0;
+}
+
+// This function calls quoneq_net::cleanup() to release any resources or settings
+// that were initialized by quoneq_net::init() earlier.
+void net_cleanup() {
+    quoneq_net::cleanup();
+    std::cout << "Cleaned up Quoneq network." << std::endl;
+}
@@ -0,0 +1,56 @@
+#include <iostream>
+
+#include <quoneq/http_session.hpp>  // For performing HTTP requests over a persistent session
+#include <quoneq/net.hpp>           // For initializing and cleaning up network resources
+
+// Define a constant for the Cat Fact API URL
+#define CAT_FACT "https://catfact.ninja/fact"
+
+// Forward declaration for the network cleanup function
+void net_cleanup();
+
+int main() {
+    // Inform the user that the network subsystem is being initialized
+    std::cout << "Initializing Quoneq..." << std::endl;
+
+    // Initialize the network resources (e.g., set up any necessary libraries or configurations)
+    quoneq_net::init();
+
+    // Scope the session so that its connections are closed before the network cleanup
+    {
+        // The session keeps its connection alive between requests,
+        // so only the first request pays for the DNS lookup and TLS handshake
+        quoneq_http_session session;
+
+        for(int i = 0; i < 3; i++) {
+            // Send an HTTP GET request to the Cat Fact API over the session
+            auto response = session.get(CAT_FACT);
+
+            // Output the HTTP status code received from the server
+            std::cout << "Response status: " << response->status << std::endl;
+
+            // If the response status is not 200 (OK), print the error message returned by the session
+            if(response->status != 200)
+                std::cout << "Error Message:" <<
+                    std::endl << response->errorMessage <<
+                    std::endl;
+            else std::cout << response->content << std::endl;
+        }
+
+        // Report how many of the requests were served over a reused connection
+        std::cout << "Reused connections: " <<
+            session.reused_connection_count() << "/" <<
+            session.request_count() << std::endl;
+    }
+
+    // Clean up network resources (release any allocated resources, etc.)
+    net_cleanup();
+    return 0;
+}
+
+// This function calls quoneq_net::cleanup() to release any resources or settings
+// that were initialized by quoneq_net::init() earlier.
+void net_cleanup() {
+    quoneq_net::cleanup();
+    std::cout << "Cleaned up Quoneq network." << std::endl;
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_body_encoder.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides streaming compression of request bodies.
+ *
+ * This header defines the quoneq_body_encoder class, which compresses a
+ * request body chunk by chunk as libcurl asks for it, so that neither the
+ * plain nor the compressed body has to be held in memory as a whole.
+ */
+#ifndef QUONEQ_BODY_ENCODER_HPP
+#define QUONEQ_BODY_ENCODER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+struct z_stream_s;
+struct ZSTD_CCtx_s;
+
+/**
+ * @brief Content coding applied to a request body.
+ *
+ * zstd is opt-in: it is only available when the library is built with
+ * QUONEQ_USE_ZSTD defined and linked against libzstd (tools/build.sh does
+ * this when pkg-config finds libzstd). Otherwise requests asking for it
+ * fail with "zstd request compression is not available".
+ */
+enum class quoneq_http_encoding {
+    identity,   ///< The body is sent as is.
+    gzip,       ///< The body is compressed with gzip (zlib).
+    zstd        ///< The body is compressed with Zstandard.
+};
+
+/**
+ * @brief Supplies request body data on demand.
+ *
+ * The source fills the buffer with up to capacity bytes and returns how
+ * many it wrote; returning 0 marks the end of the body.
+ */
+typedef std::function<size_t(char* buffer, size_t capacity)> quoneq_http_source;
+
+/**
+ * @brief Incremental compressor of a request body.
+ */
+class quoneq_body_encoder {
+private:
+    quoneq_http_encoding encoding;  ///< The content coding produced.
+    z_stream_s* zlib;               ///< gzip compression state, if used.
+    ZSTD_CCtx_s* zstd;              ///< Zstandard compression state, if used.
+    std::vector<char> input;        ///< Plain data pulled from the source.
+    size_t input_offset;            ///< Offset of the first unconsumed plain byte.
+    size_t input_length;            ///< Number of plain bytes in the input buffer.
+    bool input_done;                ///< Whether the source has been exhausted.
+    bool finished;                  ///< Whether the compressed stream is complete.
+    bool failed;                    ///< Whether compression failed.
+
+public:
+    /**
+     * @brief Creates an encoder.
+     *
+     * @param body_encoding The content coding to produce; must not be identity.
+     * @param level The compression level; 0 selects the codec's default.
+     */
+    quoneq_body_encoder(quoneq_http_encoding body_encoding, int level);
+
+    /**
+     * @brief Releases the compression state.
+     */
+    ~quoneq_body_encoder();
+
+    quoneq_body_encoder(const quoneq_body_encoder&) = delete;
+    quoneq_body_encoder& operator=(const quoneq_body_encoder&) = delete;
+
+    /**
+     * @brief Checks whether the codec was initialized successfully.
+     *
+     * @return True if the encoder can be used; false otherwise.
+     */
+    bool is_ready() const;
+
+    /**
+     * @brief Checks whether compression has failed.
+     *
+     * @return True if an error occurred; false otherwise.
+     */
+    bool has_failed() const;
+
+    /**
+     * @brief Produces the next piece of compressed data.
+     *
+     * Plain data is pulled from the source only as fast as compressed
+     * output is consumed.
+     *
+     * @param output Destination buffer.
+     * @param capacity Size of the destination buffer.
+     * @param source The source of the plain body.
+     * @return The number of compressed bytes written; 0 once the stream is
+     *         complete or if compression failed.
+     */
+    size_t read(char* output, size_t capacity, const quoneq_http_source& source);
+
+    /**
+     * @brief Returns the Content-Encoding token of a coding.
+     *
+     * @param body_encoding The content coding.
+     * @return The token, or an empty string for identity.
+     */
+    static const char* token(quoneq_http_encoding body_encoding);
+};
+
+#endif
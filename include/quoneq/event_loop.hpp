@@ -0,0 +1,99 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_event_loop.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides the background event loop behind the asynchronous APIs.
+ *
+ * This header defines the quoneq_event_loop class, which owns a single thread
+ * driving a libcurl multi handle. The asynchronous client methods hand their
+ * prepared handles to it and are notified once the transfer completes.
+ */
+#ifndef QUONEQ_EVENT_LOOP_HPP
+#define QUONEQ_EVENT_LOOP_HPP
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <curl/curl.h>
+
+/**
+ * @brief Background event loop for asynchronous transfers.
+ *
+ * The loop thread is started on the first submission and stopped by
+ * quoneq_net::cleanup(), or at exit if that is never called. Completion callbacks run on the loop thread, so
+ * they should only publish results (e.g., fulfill a promise) and return.
+ */
+class quoneq_event_loop {
+public:
+    /**
+     * @brief Callback invoked with the result of a finished transfer.
+     */
+    typedef std::function<void(CURLcode result)> completion;
+
+private:
+    static std::mutex lock;
+    static std::mutex stop_lock;
+    static std::thread worker;
+    static CURLM* multi;
+    static bool stopping;
+    static bool exit_hooked;
+    static std::vector<std::pair<CURL*, completion>> pending;
+
+    /**
+     * @brief Body of the loop thread.
+     *
+     * Adds submitted handles to the multi handle, drives all transfers and
+     * invokes the completion callback of each finished one.
+     */
+    static void run();
+
+public:
+    /**
+     * @brief Submits a prepared handle for asynchronous execution.
+     *
+     * This function is thread-safe. Ownership of the handle stays with the
+     * caller, who must not touch it until the completion callback runs.
+     *
+     * @param curl The fully configured libcurl easy handle.
+     * @param on_complete Callback invoked on the loop thread once the
+     *        transfer has finished or has been aborted.
+     */
+    static void submit(CURL* curl, completion on_complete);
+
+    /**
+     * @brief Stops the loop thread.
+     *
+     * Transfers still in progress are aborted and their completion callbacks
+     * are invoked with CURLE_ABORTED_BY_CALLBACK. Calling this function
+     * again, concurrently or after the loop has stopped, has no effect.
+     */
+    static void stop();
+};
+
+#endif
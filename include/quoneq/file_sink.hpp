@@ -0,0 +1,195 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_file_sink.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides a buffered, file-descriptor-backed writer for downloads.
+ *
+ * This header defines the quoneq_file_sink class, which the download methods
+ * use to store received data. Incoming chunks are coalesced into large
+ * aligned buffers that a writer thread hands to the kernel, so disk latency
+ * does not stall the transfer that is producing the data.
+ */
+#ifndef QUONEQ_FILE_SINK_HPP
+#define QUONEQ_FILE_SINK_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Tuning options of a quoneq_file_sink.
+ */
+typedef struct quoneq_file_sink_options_t {
+    size_t bufferSize   = 1UL << 20;    ///< Size of each staging buffer, rounded up to the block alignment.
+    size_t bufferCount  = 4;            ///< Number of staging buffers cycled between receiver and writer.
+    bool directIo       = false;        ///< Open the file with O_DIRECT, bypassing the page cache.
+    bool syncRange      = false;        ///< Start writeback with sync_file_range after every buffer.
+} quoneq_file_sink_options;
+
+/**
+ * @brief Sequential file writer with asynchronous, buffered output.
+ *
+ * Data passed to write() is copied into the current staging buffer. Full
+ * buffers are queued to a writer thread, started on the first full buffer,
+ * which writes them at their offset with pwrite() and then returns them to
+ * the pool. write() only blocks when every buffer is waiting on the disk.
+ *
+ * When O_DIRECT is requested but not supported by the file system, the file
+ * is opened without it. A sink is meant to be fed from a single thread.
+ */
+class quoneq_file_sink {
+private:
+    /**
+     * @brief A full buffer waiting to be written.
+     */
+    typedef struct block_t {
+        char* data      = nullptr;  ///< The buffer holding the data.
+        size_t length   = 0;        ///< Number of bytes of data in the buffer.
+        size_t offset   = 0;        ///< File offset the data belongs at.
+    } block;
+
+    int fd;                             ///< The output file descriptor.
+    bool direct;                        ///< Whether the file was opened with O_DIRECT.
+    bool sync_range;                    ///< Whether writeback is started after each buffer.
+    bool reserved;                      ///< Whether space was preallocated.
+    size_t buffer_size;                 ///< Size of each staging buffer.
+    size_t position;                    ///< Number of bytes accepted so far.
+    size_t submitted;                   ///< Number of bytes handed to the writer.
+    char* current;                      ///< Buffer currently being filled, if any.
+    size_t filled;                      ///< Number of bytes in the current buffer.
+    std::vector<char*> buffers;         ///< Every allocated buffer.
+    std::vector<char*> idle;            ///< Buffers available for filling.
+    std::deque<block> queued;           ///< Buffers waiting to be written.
+    std::mutex lock;                    ///< Guards idle, queued, closing and message.
+    std::condition_variable ready;      ///< Signals the writer that work is queued.
+    std::condition_variable released;   ///< Signals the receiver that a buffer is idle.
+    std::thread writer;                 ///< The writer thread, once started.
+    bool closing;                       ///< Whether the writer should exit once drained.
+    std::atomic<bool> failed;           ///< Whether any write has failed.
+    std::string message;                ///< Description of the first failure.
+
+    /**
+     * @brief Writes one block to the file.
+     *
+     * @param item The block to write.
+     * @return True if the whole block was written; false otherwise.
+     */
+    bool write_block(const block& item);
+
+    /**
+     * @brief Queues the current buffer for writing.
+     */
+    void submit();
+
+    /**
+     * @brief Body of the writer thread.
+     */
+    void run();
+
+    /**
+     * @brief Records a failure unless one was recorded already.
+     *
+     * @param reason Description of the failure.
+     */
+    void fail(const std::string& reason);
+
+public:
+    /**
+     * @brief Creates (or truncates) a file for writing.
+     *
+     * @param path Path of the file to write.
+     * @param options (Optional) Buffering and I/O options.
+     */
+    explicit quoneq_file_sink(
+        const std::string& path,
+        const quoneq_file_sink_options& options = {}
+    );
+
+    /**
+     * @brief Flushes any pending data and closes the file.
+     */
+    ~quoneq_file_sink();
+
+    quoneq_file_sink(const quoneq_file_sink&) = delete;
+    quoneq_file_sink& operator=(const quoneq_file_sink&) = delete;
+
+    /**
+     * @brief Checks whether the file was opened successfully.
+     *
+     * @return True if the file is open; false otherwise.
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Preallocates disk space for the expected file size.
+     *
+     * Only the first call has an effect. The file is trimmed to the number
+     * of bytes actually written when it is closed.
+     *
+     * @param length The expected size of the file in bytes.
+     */
+    void reserve(size_t length);
+
+    /**
+     * @brief Appends data to the file.
+     *
+     * @param data Pointer to the data.
+     * @param length Number of bytes to append.
+     * @return True if the data was accepted; false if the sink has failed.
+     */
+    bool write(const char* data, size_t length);
+
+    /**
+     * @brief Writes any pending data and closes the file.
+     *
+     * Calling close() more than once has no further effect and returns the
+     * result of the first call.
+     *
+     * @return True if every byte was written successfully; false otherwise,
+     *         including when the file could not be opened.
+     */
+    bool close();
+
+    /**
+     * @brief Returns the number of bytes accepted by write().
+     *
+     * @return The logical size of the file.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Returns a description of the first failure.
+     *
+     * @return The error message, or an empty string if nothing failed.
+     */
+    std::string error();
+};
+
+#endif
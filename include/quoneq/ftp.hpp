@@ -33,7 +33,20 @@
 #ifndef QUONEQ_FTP_HPP
 #define QUONEQ_FTP_HPP
 
+#include <quoneq/file_sink.hpp>
+#include <quoneq/ftp_listing.hpp>
+#include <quoneq/upload_source.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -51,8 +64,55 @@ typedef struct quoneq_ftp_response_t {
     std::string errorMessage        = "";   ///< Any error message generated during the operation.
     std::string content             = "";   ///< The response content from the FTP operation.
     std::vector<std::string> list   = {};   ///< Directory listing when applicable.
+    std::vector<quoneq_ftp_entry> entries = {}; ///< Typed directory entries when applicable.
 } quoneq_ftp_response;
 
+/**
+ * @brief Metadata of a single remote path, obtained without a data connection.
+ */
+typedef struct quoneq_ftp_stat_t {
+    bool exists                 = false;    ///< Whether the path exists.
+    quoneq_ftp_entry entry      = {};       ///< Type, size, modification time and permissions, as far as known.
+    std::string errorMessage    = "";       ///< Connection or login error; empty when the query was answered.
+} quoneq_ftp_stat;
+
+/**
+ * @brief Receives the entries discovered by a recursive FTP listing.
+ *
+ * The first argument is the full FTP URL of the entry and the second its
+ * typed description.
+ */
+typedef std::function<void(const std::string&, const quoneq_ftp_entry&)> quoneq_ftp_list_callback;
+
+/**
+ * @brief Direction of an FTP mirror.
+ */
+enum class quoneq_ftp_mirror_direction {
+    download,   ///< The remote directory is copied into the local one.
+    upload      ///< The local directory is copied into the remote one.
+};
+
+/**
+ * @brief Settings of an FTP mirror.
+ */
+typedef struct quoneq_ftp_mirror_options_t {
+    quoneq_ftp_mirror_direction direction   = quoneq_ftp_mirror_direction::download;   ///< Which side is copied.
+    size_t workers                          = 4;    ///< Number of concurrent sessions listing and transferring.
+    std::string manifest                    = "";   ///< File recording the synchronised state; empty disables it.
+} quoneq_ftp_mirror_options;
+
+/**
+ * @brief Outcome of an FTP mirror.
+ */
+typedef struct quoneq_ftp_mirror_result_t {
+    size_t transferred              = 0;    ///< Files copied because they were new or had changed.
+    size_t unchanged                = 0;    ///< Files skipped because both sides matched.
+    size_t failed                   = 0;    ///< Files whose transfer failed.
+    std::uint64_t bytes             = 0;    ///< Total size of the copied files.
+    std::vector<std::string> errors = {};   ///< One message per failed file, directory or listing.
+    std::string errorMessage        = "";   ///< Error that stopped the mirror, if any.
+} quoneq_ftp_mirror_result;
+
 /**
  * @brief FTP client class providing static methods for FTP operations.
  *
@@ -62,6 +122,8 @@ typedef struct quoneq_ftp_response_t {
  */
 class quoneq_ftp_client {
 private:
+    friend class quoneq_ftp_session;
+
     /**
      * @brief Callback function used by libcurl to write received data into a string.
      *
@@ -79,28 +141,40 @@ private:
     );
 
     /**
-     * @brief Callback function used by libcurl to write data to a file stream.
+     * @brief Destination of a file download.
+     */
+    typedef struct file_download_t {
+        CURL* curl                  = nullptr;  ///< The handle performing the download.
+        quoneq_file_sink* file      = nullptr;  ///< The sink receiving the data.
+        bool sized                  = false;    ///< Whether the expected size was looked up.
+    } file_download;
+
+    /**
+     * @brief Callback function used by libcurl to write data to a file.
+     *
+     * On the first chunk, the file is preallocated when the server reported
+     * the size of the file.
      *
      * @param ptr Pointer to the incoming data.
      * @param size Size of each data element.
      * @param nmemb Number of data elements.
-     * @param stream Pointer to the std::ofstream where data will be written.
+     * @param download Pointer to the download destination.
      * @return The total number of bytes processed.
      */
     static size_t write_file_callback(
         void* ptr,
         size_t size,
         size_t nmemb,
-        std::ofstream* stream
+        file_download* download
     );
 
     /**
-     * @brief Callback function used by libcurl to read data from a file.
+     * @brief Callback function used by libcurl to read upload data.
      *
      * @param ptr Pointer to the buffer where data should be stored.
      * @param size Size of each data element.
      * @param nmemb Number of data elements.
-     * @param userdata Pointer to user data (typically a file stream).
+     * @param userdata Pointer to the quoneq_upload_source being uploaded.
      * @return The total number of bytes read.
      */
     static size_t read_file_callback(
@@ -110,6 +184,166 @@ private:
         void* userdata
     );
 
+    /**
+     * @brief Callback function used by libcurl to rewind upload data.
+     *
+     * @param userdata Pointer to the quoneq_upload_source being uploaded.
+     * @param offset The offset to seek to.
+     * @param origin SEEK_SET, SEEK_CUR or SEEK_END.
+     * @return CURL_SEEKFUNC_OK on success; CURL_SEEKFUNC_FAIL otherwise.
+     */
+    static int seek_file_callback(
+        void* userdata,
+        curl_off_t offset,
+        int origin
+    );
+
+    /**
+     * @brief Returns the server part of an FTP URL with a bare "/" path.
+     *
+     * @param ftp_url The complete FTP URL.
+     * @return The scheme, credentials and host of the URL followed by "/".
+     */
+    static std::string server_root(const std::string &ftp_url);
+
+    /**
+     * @brief Points a libcurl handle at an FTP URL with the shared settings.
+     *
+     * Sets the URL, the process-wide share, the CA bundle and the credentials.
+     *
+     * @param curl The handle to configure.
+     * @param ftp_url The FTP URL (including path) to operate on.
+     * @param username FTP username.
+     * @param password FTP password.
+     */
+    static void prepare_handle(
+        CURL* curl,
+        const std::string &ftp_url,
+        const std::string &username,
+        const std::string &password
+    );
+
+    /**
+     * @brief Uploads the contents of a source to the FTP server.
+     *
+     * @param curl The handle to perform the transfer on.
+     * @param ftp_url The FTP URL (including path) where the data should be uploaded.
+     * @param source The data to upload.
+     * @param username FTP username.
+     * @param password FTP password.
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    static std::unique_ptr<quoneq_ftp_response> perform_upload(
+        CURL* curl,
+        const std::string &ftp_url,
+        quoneq_upload_source* source,
+        const std::string &username,
+        const std::string &password
+    );
+
+    /**
+     * @brief Downloads a remote file into a local file.
+     *
+     * @param curl The handle to perform the transfer on.
+     * @param ftp_url The FTP URL (including path) of the file to download.
+     * @param local_file The local file path where the file will be saved.
+     * @param username FTP username.
+     * @param password FTP password.
+     * @param sink_options Controls preallocation and durability of the local file.
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    static std::unique_ptr<quoneq_ftp_response> perform_download(
+        CURL* curl,
+        const std::string &ftp_url,
+        const std::string &local_file,
+        const std::string &username,
+        const std::string &password,
+        const quoneq_file_sink_options &sink_options
+    );
+
+    /**
+     * @brief Reads a remote file or directory listing into memory.
+     *
+     * @param curl The handle to perform the transfer on.
+     * @param ftp_url The FTP URL (including path) to read.
+     * @param username FTP username.
+     * @param password FTP password.
+     * @param names_only Whether a directory listing should contain names only.
+     * @return A unique pointer to a quoneq_ftp_response containing the content.
+     */
+    static std::unique_ptr<quoneq_ftp_response> perform_read(
+        CURL* curl,
+        const std::string &ftp_url,
+        const std::string &username,
+        const std::string &password,
+        bool names_only
+    );
+
+    /**
+     * @brief Sends raw FTP commands without transferring any data.
+     *
+     * @param curl The handle to perform the commands on.
+     * @param ftp_url Any FTP URL on the target server.
+     * @param commands The commands to send, in order.
+     * @param username FTP username.
+     * @param password FTP password.
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    static std::unique_ptr<quoneq_ftp_response> perform_commands(
+        CURL* curl,
+        const std::string &ftp_url,
+        const std::vector<std::string> &commands,
+        const std::string &username,
+        const std::string &password
+    );
+
+    /**
+     * @brief Looks up the metadata of a remote path over the control connection.
+     *
+     * Servers advertising MLST answer with one MLST command. Otherwise the
+     * path is probed as a file with SIZE (and MDTM when supported) and, if
+     * that fails, as a directory with CWD. Servers supporting neither MLST
+     * nor SIZE cannot tell a missing file apart, so the parent directory is
+     * listed instead.
+     *
+     * @param curl The handle to perform the query on.
+     * @param ftp_url The FTP URL (including path) to look up.
+     * @param username FTP username.
+     * @param password FTP password.
+     * @return The metadata of the path.
+     */
+    static quoneq_ftp_stat perform_stat(
+        CURL* curl,
+        const std::string &ftp_url,
+        const std::string &username,
+        const std::string &password
+    );
+
+    /**
+     * @brief State of an asynchronous download running on the event loop.
+     */
+    typedef struct async_download_t {
+        std::unique_ptr<quoneq_file_sink> outfile       = nullptr;  ///< Destination file.
+        file_download destination                       = {};       ///< Write callback state.
+        std::unique_ptr<quoneq_ftp_response> response   = nullptr;  ///< The response being populated.
+        std::promise<std::unique_ptr<quoneq_ftp_response>> promise{};   ///< Fulfilled on completion.
+    } async_download;
+
+    /**
+     * @brief Configures a libcurl handle to download a file.
+     *
+     * @param download The download destination; its handle is configured.
+     * @param ftp_url The FTP URL (including path) of the file to download.
+     * @param username FTP username.
+     * @param password FTP password.
+     */
+    static void prepare_download(
+        file_download* download,
+        const std::string &ftp_url,
+        const std::string &username,
+        const std::string &password
+    );
+
     /**
      * @brief Extracts the FTP path from a given FTP URL.
      *
@@ -118,6 +352,33 @@ private:
      */
     static std::string extract_ftp_path(const std::string &ftp_url);
 
+    /**
+     * @brief Percent-encodes each component of a path for use in an FTP URL.
+     *
+     * The '/' separators are kept, everything else that is not unreserved
+     * (spaces, '#', '?', '%' and so on) is encoded.
+     *
+     * @param path The plain path or name.
+     * @return The path as it appears in a URL.
+     */
+    static std::string escape_path(const std::string &path);
+
+    /**
+     * @brief Decodes the percent-encoding of a URL path.
+     *
+     * @param path The path as it appears in a URL.
+     * @return The plain path.
+     */
+    static std::string unescape_path(const std::string &path);
+
+    /**
+     * @brief Extracts the plain server path of an FTP URL for raw FTP commands.
+     *
+     * @param ftp_url The complete FTP URL.
+     * @return The decoded path, as DELE, MKD, RNFR, RNTO and MLST expect it.
+     */
+    static std::string command_path(const std::string &ftp_url);
+
     /**
      * @brief Splits a string into substrings based on a delimiter.
      *
@@ -131,51 +392,166 @@ private:
     );
 
     /**
-     * @brief Retrieves a detailed directory listing from an FTP server.
+     * @brief Optional FTP extensions (RFC 3659) advertised by a server.
+     */
+    typedef struct server_features_t {
+        bool mlst   = false;    ///< MLST and MLSD are supported.
+        bool size   = false;    ///< SIZE is supported.
+        bool mdtm   = false;    ///< MDTM is supported.
+    } server_features;
+
+    static std::map<std::string, server_features> features;    ///< Probed features, by server URL.
+    static std::mutex feature_lock;                             ///< Guards features.
+
+    /**
+     * @brief Returns the features of a server, asking it with FEAT on first use.
      *
-     * @param ftp_url The FTP URL of the directory to list.
+     * The answer is cached per server, so later calls cost no round trip.
+     * The handle is left ready for the next transfer on the same connection.
+     *
+     * @param curl The handle to send FEAT on.
+     * @param ftp_url Any FTP URL on the server.
      * @param username FTP username.
      * @param password FTP password.
-     * @return A vector of strings representing each line of the directory listing.
+     * @return The features the server advertised.
      */
-    static std::vector<std::string> get_list_detail(
+    static server_features probe_features(
+        CURL* curl,
         const std::string &ftp_url,
         const std::string &username,
         const std::string &password
     );
 
     /**
-     * @brief Parses a single line of an FTP directory listing.
+     * @brief Lists a remote directory as typed entries.
+     *
+     * Uses MLSD when the server advertises MLST and LIST otherwise.
      *
-     * @param line A line from the FTP list output.
-     * @return A pair where the first element indicates whether parsing was successful
-     *         and the second element is the parsed detail string.
+     * @param curl The handle to perform the listing on.
+     * @param ftp_url The FTP URL of the directory.
+     * @param username FTP username.
+     * @param password FTP password.
+     * @return A unique pointer to a quoneq_ftp_response containing the entries.
      */
-    static std::pair<bool, std::string> parse_ftp_list_line(
-        const std::string &line
+    static std::unique_ptr<quoneq_ftp_response> perform_list_entries(
+        CURL* curl,
+        const std::string &ftp_url,
+        const std::string &username,
+        const std::string &password
     );
 
     /**
-     * @brief Helper function to recursively list directory contents from an FTP server.
+     * @brief Shared state of a parallel recursive listing.
+     */
+    typedef struct crawl_state_t {
+        std::string root                    = "";       ///< Server URL every worker connects to.
+        std::string username                = "";       ///< FTP username.
+        std::string password                = "";       ///< FTP password.
+        std::deque<std::string> pending     = {};       ///< Directory URLs waiting to be listed.
+        size_t outstanding                  = 0;        ///< Directories queued or being listed.
+        std::string error                   = "";       ///< First listing error encountered.
+        std::mutex lock{};                              ///< Guards the queue, counter and error.
+        std::condition_variable ready{};                ///< Signalled when work is queued or finished.
+        std::mutex callback_lock{};                     ///< Serializes calls to the callback.
+        const quoneq_ftp_list_callback* callback = nullptr; ///< Receives every discovered entry.
+    } crawl_state;
+
+    static size_t server_limit;                             ///< Maximum concurrent crawl connections per server.
+    static std::map<std::string, size_t> server_connections;    ///< Crawl connections open, by server URL.
+    static std::mutex server_lock;                          ///< Guards server_connections.
+    static std::condition_variable server_available;        ///< Signalled when a server slot is released.
+
+    /**
+     * @brief Waits until a connection to the server is allowed and claims it.
      *
-     * This function accumulates directory listing entries into a provided vector.
+     * @param server The server URL.
+     */
+    static void acquire_server_slot(const std::string &server);
+
+    /**
+     * @brief Releases a connection slot claimed with acquire_server_slot().
      *
-     * @param ftp_url The base FTP URL.
-     * @param username FTP username.
-     * @param password FTP password.
-     * @param accum Reference to the vector accumulating directory listing entries.
+     * @param server The server URL.
      */
-    static void list_recursive_helper(
-        const std::string &ftp_url,
-        const std::string &username,
-        const std::string &password,
-        std::vector<std::string> &accum
+    static void release_server_slot(const std::string &server);
+
+    /**
+     * @brief Lists directories from the shared queue until the crawl is done.
+     *
+     * Each worker owns one session, so every directory it lists reuses the
+     * same control connection. Subdirectories are appended to the back of
+     * the queue, which makes the walk breadth-first.
+     *
+     * @param state The crawl shared by all workers.
+     */
+    static void crawl_worker(crawl_state* state);
+
+    /**
+     * @brief Size and modification time of both copies of a mirrored file.
+     */
+    typedef struct mirror_record_t {
+        std::int64_t remoteSize         = -1;   ///< Size of the remote file, or -1 if unknown.
+        std::time_t remoteModified      = -1;   ///< Modification time of the remote file, or -1 if unknown.
+        std::int64_t localSize          = -1;   ///< Size of the local file, or -1 if unknown.
+        std::time_t localModified       = -1;   ///< Modification time of the local file, or -1 if unknown.
+    } mirror_record;
+
+    /**
+     * @brief A file seen on either side of a mirror.
+     */
+    typedef struct mirror_file_t {
+        std::string relative    = "";       ///< Path relative to the mirrored directories.
+        mirror_record state     = {};       ///< Current state of both copies.
+        bool remote             = false;    ///< Whether the remote copy exists.
+        bool local              = false;    ///< Whether the local copy exists.
+    } mirror_file;
+
+    /**
+     * @brief Reads a mirror manifest.
+     *
+     * @param path The manifest file.
+     * @return The recorded state of every file, by relative path; empty if the file is missing.
+     */
+    static std::map<std::string, mirror_record> load_manifest(const std::string &path);
+
+    /**
+     * @brief Writes a mirror manifest, replacing the previous one atomically.
+     *
+     * @param path The manifest file.
+     * @param manifest The state of every synchronised file, by relative path.
+     * @return true if the manifest was written.
+     */
+    static bool save_manifest(
+        const std::string &path,
+        const std::map<std::string, mirror_record> &manifest
+    );
+
+    /**
+     * @brief Decides whether a file needs no transfer.
+     *
+     * With a manifest record, the file is unchanged when both copies still
+     * look exactly as recorded after the last transfer. Without one, the
+     * sizes must match and the destination must be at least as recent as
+     * the source (downloads stamp the local copy with the remote time).
+     *
+     * @param file The file as seen now.
+     * @param previous The manifest record of the file, or nullptr.
+     * @param direction The direction of the mirror.
+     * @return true if the destination is up to date.
+     */
+    static bool mirror_unchanged(
+        const mirror_file &file,
+        const mirror_record* previous,
+        quoneq_ftp_mirror_direction direction
     );
 
 public:
     /**
      * @brief Uploads a local file to the specified FTP server.
      *
+     * The file is memory-mapped and served to libcurl directly from the
+     * mapping.
+     *
      * @param ftp_url The FTP URL (including path) where the file should be uploaded.
      * @param local_file Path to the local file to be uploaded.
      * @param username FTP username (optional).
@@ -189,6 +565,25 @@ public:
         const std::string &password = ""
     );
 
+    /**
+     * @brief Uploads an in-memory buffer to the specified FTP server.
+     *
+     * The buffer is sent in place, without being copied or written to a
+     * temporary file first.
+     *
+     * @param ftp_url The FTP URL (including path) where the data should be uploaded.
+     * @param data The bytes to upload.
+     * @param username FTP username (optional).
+     * @param password FTP password (optional).
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    static std::unique_ptr<quoneq_ftp_response> upload(
+        const std::string &ftp_url,
+        std::span<const std::byte> data,
+        const std::string &username = "",
+        const std::string &password = ""
+    );
+
     /**
      * @brief Downloads a file from the FTP server and saves it locally.
      *
@@ -196,13 +591,36 @@ public:
      * @param local_file The local file path where the downloaded file will be saved.
      * @param username FTP username (optional).
      * @param password FTP password (optional).
+     * @param sink_options Buffering and I/O options of the local file (optional).
      * @return A unique pointer to a quoneq_ftp_response containing the operation response.
      */
     static std::unique_ptr<quoneq_ftp_response> download_file(
         const std::string &ftp_url,
         const std::string &local_file,
         const std::string &username = "",
-        const std::string &password = ""
+        const std::string &password = "",
+        const quoneq_file_sink_options &sink_options = {}
+    );
+
+    /**
+     * @brief Downloads a file from the FTP server asynchronously.
+     *
+     * The transfer is performed by the internal event loop, leaving the
+     * calling thread free until the future is consulted.
+     *
+     * @param ftp_url The FTP URL (including path) of the file to download.
+     * @param local_file The local file path where the downloaded file will be saved.
+     * @param username FTP username (optional).
+     * @param password FTP password (optional).
+     * @param sink_options Buffering and I/O options of the local file (optional).
+     * @return A future resolving to the operation response once the transfer completes.
+     */
+    static std::future<std::unique_ptr<quoneq_ftp_response>> download_file_async(
+        const std::string &ftp_url,
+        const std::string &local_file,
+        const std::string &username = "",
+        const std::string &password = "",
+        const quoneq_file_sink_options &sink_options = {}
     );
 
     /**
@@ -247,9 +665,31 @@ public:
         const std::string &password = ""
     );
 
+    /**
+     * @brief Lists a remote directory as typed entries.
+     *
+     * Uses MLSD when the server advertises it, so names, types, sizes,
+     * modification times and permissions come from machine-readable facts.
+     * Otherwise the LIST output is parsed, in either the Unix or the
+     * Windows/IIS format.
+     *
+     * @param ftp_url The FTP URL of the directory.
+     * @param username FTP username (optional).
+     * @param password FTP password (optional).
+     * @return A unique pointer to a quoneq_ftp_response whose entries hold the directory contents.
+     */
+    static std::unique_ptr<quoneq_ftp_response> list_entries(
+        const std::string &ftp_url,
+        const std::string &username = "",
+        const std::string &password = ""
+    );
+
     /**
      * @brief Recursively lists all files and directories starting from the specified FTP URL.
      *
+     * The entries are collected by the streaming overload and returned sorted,
+     * so every directory precedes its contents.
+     *
      * @param ftp_url The FTP URL of the root directory.
      * @param username FTP username (optional).
      * @param password FTP password (optional).
@@ -261,6 +701,68 @@ public:
         const std::string &password = ""
     );
 
+    /**
+     * @brief Recursively lists a directory tree, streaming entries as they are found.
+     *
+     * The tree is walked breadth-first by a pool of workers, each holding one
+     * persistent session and pulling directories from a shared queue. The
+     * number of connections a server receives is further capped by
+     * set_server_connection_limit(), across all concurrent listings.
+     *
+     * The callback runs on the worker threads, one call at a time.
+     *
+     * @param ftp_url The FTP URL of the root directory.
+     * @param callback Receives the URL and the typed entry of everything found.
+     * @param workers (Optional) Number of concurrent sessions.
+     * @param username FTP username (optional).
+     * @param password FTP password (optional).
+     * @return A unique pointer to a quoneq_ftp_response carrying the first listing error, if any.
+     */
+    static std::unique_ptr<quoneq_ftp_response> list_recursive(
+        const std::string &ftp_url,
+        const quoneq_ftp_list_callback &callback,
+        size_t workers = 4,
+        const std::string &username = "",
+        const std::string &password = ""
+    );
+
+    /**
+     * @brief Sets how many connections recursive listings may open to one server.
+     *
+     * The limit is shared by all listings running in the process.
+     *
+     * @param limit Maximum number of concurrent connections per server.
+     */
+    static void set_server_connection_limit(size_t limit);
+
+    /**
+     * @brief Mirrors a remote directory tree and a local one.
+     *
+     * Both trees are compared by size and modification time, using the
+     * typed entries of a parallel recursive listing on the remote side and
+     * the file system on the local side. Only new or changed files are
+     * copied, by a pool of sessions; missing directories are created on the
+     * destination. Nothing is deleted from the destination.
+     *
+     * When a manifest file is given, the state of both copies after each
+     * transfer is recorded there, so the next run can tell unchanged files
+     * apart with certainty even when the server reports coarse times.
+     *
+     * @param ftp_url The FTP URL of the remote directory.
+     * @param local_dir The local directory.
+     * @param options (Optional) Direction, number of sessions and manifest file.
+     * @param username FTP username (optional).
+     * @param password FTP password (optional).
+     * @return A summary of the files copied, skipped and failed.
+     */
+    static quoneq_ftp_mirror_result mirror(
+        const std::string &ftp_url,
+        const std::string &local_dir,
+        const quoneq_ftp_mirror_options &options = {},
+        const std::string &username = "",
+        const std::string &password = ""
+    );
+
     /**
      * @brief Moves or renames a file or directory on the FTP server.
      *
@@ -277,6 +779,25 @@ public:
         const std::string &password = ""
     );
 
+    /**
+     * @brief Retrieves the metadata of a remote file or directory.
+     *
+     * The query runs entirely on the control connection, using MLST when the
+     * server advertises it and SIZE/MDTM or a CWD probe otherwise, so no file
+     * content or listing is transferred. A path below a missing or
+     * inaccessible directory is reported as not existing, not as an error.
+     *
+     * @param ftp_url The FTP URL to look up.
+     * @param username FTP username (optional).
+     * @param password FTP password (optional).
+     * @return The metadata of the path.
+     */
+    static quoneq_ftp_stat stat(
+        const std::string &ftp_url,
+        const std::string &username = "",
+        const std::string &password = ""
+    );
+
     /**
      * @brief Checks if a file or directory exists on the FTP server.
      *
@@ -0,0 +1,173 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_ftp_listing.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides typed FTP directory entries and the parsers producing them.
+ *
+ * This header defines quoneq_ftp_entry, a compact description of one remote
+ * file or directory, and quoneq_ftp_listing, which builds entries from
+ * machine-readable MLSD/MLST facts or from human-readable LIST output in the
+ * Unix and Windows/IIS formats.
+ */
+#ifndef QUONEQ_FTP_LISTING_HPP
+#define QUONEQ_FTP_LISTING_HPP
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Kind of a remote directory entry.
+ */
+enum class quoneq_ftp_entry_type : unsigned char {
+    file,       ///< A regular file.
+    directory,  ///< A directory.
+    link,       ///< A symbolic link.
+    other       ///< Anything else, or a type the server did not report.
+};
+
+/**
+ * @brief One entry of a remote directory listing.
+ *
+ * Fields the server did not report keep their default values.
+ */
+typedef struct quoneq_ftp_entry_t {
+    std::string name            = "";   ///< Name of the entry, without its directory.
+    std::int64_t size           = -1;   ///< Size in bytes, or -1 if unknown.
+    std::time_t modified        = -1;   ///< Last modification time (UTC), or -1 if unknown.
+    std::uint16_t permissions   = 0;    ///< POSIX permission bits, or 0 if unknown.
+    quoneq_ftp_entry_type type  = quoneq_ftp_entry_type::other;    ///< Kind of the entry.
+} quoneq_ftp_entry;
+
+/**
+ * @brief Parsers for FTP directory listings.
+ *
+ * All parsers work on string views of the raw listing and only allocate
+ * for the names of the entries they return.
+ */
+class quoneq_ftp_listing {
+private:
+    /**
+     * @brief Converts a UTC calendar date and time to a time_t.
+     *
+     * @return The time, or -1 if a field is out of range.
+     */
+    static std::time_t make_time(
+        int year,
+        int month,
+        int day,
+        int hour,
+        int minute,
+        int second
+    );
+
+    /**
+     * @brief Parses a Unix "ls -l" listing line.
+     *
+     * The owner and group columns are optional; the date is located by its
+     * month name followed by a day and a time or year, so servers omitting
+     * either column, or owners and groups named like a month, are handled.
+     *
+     * @param line The listing line.
+     * @param entry Receives the parsed entry.
+     * @param now The current time, used to infer the year of recent dates.
+     * @return true if the line was recognised.
+     */
+    static bool parse_unix_line(
+        std::string_view line,
+        quoneq_ftp_entry &entry,
+        std::time_t now
+    );
+
+    /**
+     * @brief Parses a Windows/IIS (MS-DOS style) listing line.
+     *
+     * @param line The listing line, e.g. "01-15-24  10:30AM  <DIR>  name".
+     * @param entry Receives the parsed entry.
+     * @return true if the line was recognised.
+     */
+    static bool parse_dos_line(std::string_view line, quoneq_ftp_entry &entry);
+
+public:
+    /**
+     * @brief Parses one MLSD line or MLST fact line (RFC 3659).
+     *
+     * @param line The line, e.g. "type=file;size=12;modify=20240101120000; name".
+     * @param entry Receives the parsed entry.
+     * @param listing Whether the line comes from an MLSD listing, whose entries
+     *        for the listed directory itself and its parent are rejected.
+     * @return true if the line carried facts and a name.
+     */
+    static bool parse_facts(
+        std::string_view line,
+        quoneq_ftp_entry &entry,
+        bool listing = true
+    );
+
+    /**
+     * @brief Parses one LIST line in the Unix or Windows/IIS format.
+     *
+     * @param line The listing line.
+     * @param entry Receives the parsed entry.
+     * @param now The current time, used to infer the year of recent Unix dates.
+     * @return true if the line was recognised.
+     */
+    static bool parse_list_line(
+        std::string_view line,
+        quoneq_ftp_entry &entry,
+        std::time_t now
+    );
+
+    /**
+     * @brief Checks whether a listed name is a single, plain path component.
+     *
+     * Names are joined to local and remote paths, so anything that could
+     * climb out of the listed directory is refused.
+     *
+     * @param name The entry name reported by the server.
+     * @return false for empty names, "." and "..", and names containing
+     *         '/', '\' or NUL.
+     */
+    static bool safe_name(std::string_view name);
+
+    /**
+     * @brief Parses a whole directory listing.
+     *
+     * Lines that describe the directory itself or its parent, "total" lines,
+     * unrecognised lines and entries whose name fails safe_name() are skipped.
+     *
+     * @param content The raw listing.
+     * @param machine Whether the listing came from MLSD rather than LIST.
+     * @return The entries of the listing, in server order.
+     */
+    static std::vector<quoneq_ftp_entry> parse(
+        std::string_view content,
+        bool machine
+    );
+};
+
+#endif
@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_ftp_session.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides a persistent FTP session bound to one server.
+ *
+ * This header defines the quoneq_ftp_session class, which keeps a single
+ * logged-in control connection open across FTP operations instead of
+ * connecting and authenticating again for every call.
+ */
+#ifndef QUONEQ_FTP_SESSION_HPP
+#define QUONEQ_FTP_SESSION_HPP
+
+#include <quoneq/ftp.hpp>
+
+#include <cstddef>
+
+/**
+ * @brief Stateful FTP client that keeps its control connection open.
+ *
+ * A quoneq_ftp_session is bound to one server and one set of credentials.
+ * It owns a libcurl handle for its whole lifetime, so the control connection
+ * (and the login performed on it) is reused by every operation. Because the
+ * connection persists, libcurl also skips the CWD when consecutive operations
+ * work in the same directory, and keeps using whichever passive mode (EPSV or
+ * PASV) the server accepted first.
+ *
+ * Paths passed to a session are server paths such as "/pub/file.txt"; they
+ * are appended to the server URL given at construction.
+ *
+ * A session is not thread-safe; use one session per thread.
+ */
+class quoneq_ftp_session {
+private:
+    CURL* curl;             ///< The persistent libcurl easy handle.
+    std::string root;       ///< Server URL without a trailing slash, e.g. "ftp://host:21".
+    std::string username;   ///< FTP username used for every operation.
+    std::string password;   ///< FTP password used for every operation.
+    size_t operations;      ///< Number of operations performed.
+    size_t connections;     ///< Number of control connections opened.
+    long control_port;      ///< Local port of the current control connection.
+
+    /**
+     * @brief Builds the full FTP URL of a server path.
+     *
+     * @param path The server path.
+     * @return The server URL followed by the path.
+     */
+    std::string url(const std::string &path) const;
+
+    /**
+     * @brief Resets the handle before a new operation.
+     *
+     * Clears the options of the previous operation while keeping the
+     * connection cache intact, then applies the session-wide options.
+     */
+    void prepare();
+
+    /**
+     * @brief Updates the connection statistics after an operation.
+     */
+    void track();
+
+public:
+    /**
+     * @brief Creates a new FTP session.
+     *
+     * No connection is made until the first operation.
+     *
+     * @param server_url The server URL, e.g. "ftp://example.com" or "ftp://example.com:2121".
+     * @param user (Optional) FTP username.
+     * @param pass (Optional) FTP password.
+     */
+    explicit quoneq_ftp_session(
+        const std::string &server_url,
+        const std::string &user = "",
+        const std::string &pass = ""
+    );
+
+    /**
+     * @brief Destroys the session and closes its control connection.
+     */
+    ~quoneq_ftp_session();
+
+    quoneq_ftp_session(const quoneq_ftp_session&) = delete;
+    quoneq_ftp_session& operator=(const quoneq_ftp_session&) = delete;
+
+    /**
+     * @brief Uploads a local file over the session.
+     *
+     * @param path The server path where the file should be uploaded.
+     * @param local_file The local file path to upload.
+     * @return A unique pointer to a quoneq_ftp_response containing the upload response.
+     */
+    std::unique_ptr<quoneq_ftp_response> upload(
+        const std::string &path,
+        const std::string &local_file
+    );
+
+    /**
+     * @brief Uploads an in-memory buffer over the session.
+     *
+     * @param path The server path where the data should be uploaded.
+     * @param data The bytes to upload; they must stay valid for the duration of the call.
+     * @return A unique pointer to a quoneq_ftp_response containing the upload response.
+     */
+    std::unique_ptr<quoneq_ftp_response> upload(
+        const std::string &path,
+        std::span<const std::byte> data
+    );
+
+    /**
+     * @brief Downloads a remote file over the session.
+     *
+     * @param path The server path of the file to download.
+     * @param local_file The local file path where the file will be saved.
+     * @param sink_options (Optional) Controls preallocation and durability of the local file.
+     * @return A unique pointer to a quoneq_ftp_response containing the download response.
+     */
+    std::unique_ptr<quoneq_ftp_response> download_file(
+        const std::string &path,
+        const std::string &local_file,
+        const quoneq_file_sink_options &sink_options = {}
+    );
+
+    /**
+     * @brief Reads the content of a remote file over the session.
+     *
+     * @param path The server path of the file to read.
+     * @return A unique pointer to a quoneq_ftp_response containing the file content.
+     */
+    std::unique_ptr<quoneq_ftp_response> read(const std::string &path);
+
+    /**
+     * @brief Lists the names in a remote directory over the session.
+     *
+     * @param path The server path of the directory, ending with "/".
+     * @return A unique pointer to a quoneq_ftp_response containing the listing.
+     */
+    std::unique_ptr<quoneq_ftp_response> list(const std::string &path);
+
+    /**
+     * @brief Lists a remote directory as typed entries over the session.
+     *
+     * @param path The server path of the directory.
+     * @return A unique pointer to a quoneq_ftp_response whose entries hold the directory contents.
+     */
+    std::unique_ptr<quoneq_ftp_response> list_entries(const std::string &path);
+
+    /**
+     * @brief Removes a remote file over the session.
+     *
+     * @param path The server path of the file to remove.
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    std::unique_ptr<quoneq_ftp_response> remove(const std::string &path);
+
+    /**
+     * @brief Moves or renames a remote file over the session.
+     *
+     * @param path_from The current server path.
+     * @param path_to The new server path.
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    std::unique_ptr<quoneq_ftp_response> move(
+        const std::string &path_from,
+        const std::string &path_to
+    );
+
+    /**
+     * @brief Creates a remote directory over the session.
+     *
+     * @param path The server path of the directory to create.
+     * @return A unique pointer to a quoneq_ftp_response containing the operation response.
+     */
+    std::unique_ptr<quoneq_ftp_response> create(const std::string &path);
+
+    /**
+     * @brief Retrieves the metadata of a remote path without a data connection.
+     *
+     * @param path The server path to look up.
+     * @return The metadata of the path.
+     */
+    quoneq_ftp_stat stat(const std::string &path);
+
+    /**
+     * @brief Checks whether a remote path exists.
+     *
+     * @param path The server path to check.
+     * @return true if the path exists, false otherwise.
+     */
+    bool exists(const std::string &path);
+
+    /**
+     * @brief Checks whether a remote path is a file.
+     *
+     * @param path The server path to check.
+     * @return true if the path is a file, false otherwise.
+     */
+    bool is_file(const std::string &path);
+
+    /**
+     * @brief Checks whether a remote path is a directory.
+     *
+     * @param path The server path to check.
+     * @return true if the path is a directory, false otherwise.
+     */
+    bool is_folder(const std::string &path);
+
+    /**
+     * @brief Retrieves information about a remote file.
+     *
+     * @param path The server path of the file.
+     * @return A unique pointer to a quoneq_ftp_response containing the file information.
+     */
+    std::unique_ptr<quoneq_ftp_response> file_info(const std::string &path);
+
+    /**
+     * @brief Retrieves information about a remote directory.
+     *
+     * @param path The server path of the directory.
+     * @return A unique pointer to a quoneq_ftp_response containing the directory information.
+     */
+    std::unique_ptr<quoneq_ftp_response> folder_info(const std::string &path);
+
+    /**
+     * @brief Returns the number of operations performed by this session.
+     *
+     * @return The total operation count.
+     */
+    size_t operation_count() const;
+
+    /**
+     * @brief Returns the number of control connections the session has opened.
+     *
+     * A value of one after many operations means every operation reused the
+     * same logged-in connection.
+     *
+     * @return The number of connections opened.
+     */
+    size_t connection_count() const;
+};
+
+#endif
@@ -32,12 +32,288 @@
 #ifndef QUONEQ_HTTP_HPP
 #define QUONEQ_HTTP_HPP
 
+#include <quoneq/body_encoder.hpp>
+#include <quoneq/file_sink.hpp>
+#include <quoneq/upload_source.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <curl/curl.h>
 
+/**
+ * @brief Case-insensitive ordering for HTTP header field names.
+ *
+ * The comparator is transparent, so header maps can be searched with a
+ * std::string_view or a string literal without allocating a key. It is also
+ * used on its own for case-insensitive name comparisons.
+ */
+typedef struct quoneq_http_header_less_t {
+    typedef void is_transparent;
+
+    bool operator()(std::string_view left, std::string_view right) const;
+} quoneq_http_header_less;
+
+/**
+ * @brief Flat, arena-backed table of HTTP header fields.
+ *
+ * All names and values are stored back to back in a single buffer, and each
+ * field is an entry of offsets and lengths into it. A response with dozens
+ * of headers therefore costs two allocations instead of two per field.
+ * Lookups are case-insensitive linear scans over the contiguous entries.
+ * Repeated fields are kept as separate entries, in the order received.
+ *
+ * Views returned by the table stay valid until it is modified.
+ *
+ * The table replaced the std::map that quoneq_http_response::header and
+ * quoneq_http_response::cookies used to be. Read-only map code keeps
+ * compiling: `operator[]` and at() return a std::string, and find(), count(),
+ * begin()/end() and `it->first`/`it->second` behave like their map
+ * counterparts. What changed: fields are iterated in the order received
+ * rather than sorted, repeated fields are separate entries, names and values
+ * are std::string_view, and the table cannot be modified through `operator[]`.
+ * Use to_map() where a real std::map is needed.
+ */
+class quoneq_http_headers {
+private:
+    /**
+     * @brief Location of one field within the arena.
+     */
+    typedef struct entry_t {
+        uint32_t key_offset     = 0;    ///< Offset of the name in the arena.
+        uint32_t key_length     = 0;    ///< Length of the name.
+        uint32_t value_offset   = 0;    ///< Offset of the value in the arena.
+        uint32_t value_length   = 0;    ///< Length of the value.
+    } entry;
+
+    std::string arena           = "";   ///< Buffer holding every name and value.
+    std::vector<entry> entries  = {};   ///< Fields in the order they were added.
+
+public:
+    /**
+     * @brief A header field as a name and value pair.
+     */
+    typedef std::pair<std::string_view, std::string_view> value_type;
+
+    /**
+     * @brief Forward iterator over the header fields.
+     */
+    class const_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::pair<std::string_view, std::string_view> value_type;
+        typedef const value_type* pointer;
+        typedef value_type reference;
+
+    private:
+        const quoneq_http_headers* table;   ///< The table being iterated.
+        size_t position;                    ///< Index of the current field.
+        value_type field;                   ///< The current field, for operator->.
+
+        /**
+         * @brief Refreshes the cached field after the position changed.
+         */
+        void load();
+
+    public:
+
+        /**
+         * @brief Creates a singular iterator.
+         */
+        const_iterator();
+
+        /**
+         * @brief Creates an iterator at the given field index.
+         *
+         * @param headers The table to iterate.
+         * @param index Index of the field to start at.
+         */
+        const_iterator(const quoneq_http_headers* headers, size_t index);
+
+        /**
+         * @brief Returns the current field.
+         *
+         * @return The name and value of the current field.
+         */
+        value_type operator*() const;
+
+        /**
+         * @brief Accesses the current field, as `it->first` and `it->second`.
+         *
+         * @return A pointer to the name and value of the current field.
+         */
+        pointer operator->() const;
+
+        /**
+         * @brief Advances to the next field.
+         *
+         * @return A reference to this iterator.
+         */
+        const_iterator& operator++();
+
+        /**
+         * @brief Advances to the next field.
+         *
+         * @return A copy of this iterator before it was advanced.
+         */
+        const_iterator operator++(int);
+
+        /**
+         * @brief Compares two iterators.
+         *
+         * @param other The iterator to compare with.
+         * @return true if both iterators point at the same field.
+         */
+        bool operator==(const const_iterator& other) const;
+    };
+
+    /**
+     * @brief Appends a header field.
+     *
+     * @param key The field name.
+     * @param value The field value.
+     */
+    void add(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Removes every field, keeping the allocated capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of fields, counting repeated ones separately.
+     *
+     * @return The number of fields.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Checks whether the table holds no fields.
+     *
+     * @return true if the table is empty.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Checks whether a field is present.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return true if at least one field has that name.
+     */
+    bool contains(std::string_view key) const;
+
+    /**
+     * @brief Returns the value of the first field with the given name.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return The value, or an empty view if the field is absent.
+     */
+    std::string_view get(std::string_view key) const;
+
+    /**
+     * @brief Returns the values of every field with the given name.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return The values, in the order they were received.
+     */
+    std::vector<std::string_view> get_all(std::string_view key) const;
+
+    /**
+     * @brief Counts the fields with the given name.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return The number of fields with that name; repeated fields count
+     *         separately, so this may exceed 1 unlike std::map::count().
+     */
+    size_t count(std::string_view key) const;
+
+    /**
+     * @brief Finds the first field with the given name.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return An iterator to the field, or end() if it is absent.
+     */
+    const_iterator find(std::string_view key) const;
+
+    /**
+     * @brief Returns a copy of the value of the first field with the given name.
+     *
+     * Kept so that `header["Name"]` lookups written against the former
+     * std::map keep compiling, including assignments to a std::string.
+     * Unlike std::map, an absent field is not inserted. Prefer get(), which
+     * does not copy.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return The value, or an empty string if the field is absent.
+     */
+    const std::string operator[](std::string_view key) const;
+
+    /**
+     * @brief Returns a copy of the value of the first field with the given name.
+     *
+     * @param key The field name, compared case-insensitively.
+     * @return The value.
+     * @throws std::out_of_range if no field has that name, like std::map::at().
+     */
+    std::string at(std::string_view key) const;
+
+    /**
+     * @brief Returns an iterator to the first field.
+     *
+     * @return The begin iterator.
+     */
+    const_iterator begin() const;
+
+    /**
+     * @brief Returns an iterator past the last field.
+     *
+     * @return The end iterator.
+     */
+    const_iterator end() const;
+
+    /**
+     * @brief Copies the fields into a map.
+     *
+     * Compatibility accessor for code written against the former
+     * std::map representation. Repeated fields are combined into one
+     * comma-separated value.
+     *
+     * @return A map of field names to values with case-insensitive names.
+     */
+    std::map<std::string, std::string, quoneq_http_header_less> to_map() const;
+};
+
+/**
+ * @brief Timing breakdown of a transfer.
+ *
+ * Every phase is measured from the start of the transfer, so the values are
+ * cumulative: connect includes nameLookup, firstByte includes preTransfer,
+ * and so on. Phases that did not take place, such as the TLS handshake of a
+ * plain HTTP request or the connect of a reused connection, are zero.
+ */
+typedef struct quoneq_http_timing_t {
+    std::chrono::microseconds nameLookup    = {};   ///< Until the host name was resolved.
+    std::chrono::microseconds connect       = {};   ///< Until the TCP connection was established.
+    std::chrono::microseconds appConnect    = {};   ///< Until the TLS handshake completed.
+    std::chrono::microseconds preTransfer   = {};   ///< Until the request was about to be sent.
+    std::chrono::microseconds firstByte     = {};   ///< Until the first response byte arrived.
+    std::chrono::microseconds total         = {};   ///< Until the transfer completed.
+} quoneq_http_timing;
+
 /**
  * @brief Represents an HTTP response.
  *
@@ -50,10 +326,97 @@ typedef struct quoneq_http_response_t {
     std::string statusType                      = "";   ///< HTTP status text (e.g., "OK").
     std::string errorMessage                    = "";   ///< Error message, if any.
     std::string content                         = "";   ///< The response body content.
-    std::map<std::string, std::string> header   = {};   ///< Map of HTTP response header fields.
-    std::map<std::string, std::string> cookies  = {};   ///< Map of cookies received in the response.
+    size_t contentLength                        = 0;    ///< Body length announced by the Content-Length header, 0 if unknown.
+    size_t wireLength                           = 0;    ///< Body bytes received on the wire, before content decoding.
+    size_t decodedLength                        = 0;    ///< Body bytes delivered after content decoding.
+    std::string httpVersion                     = "";   ///< Negotiated protocol version (e.g., "HTTP/1.1", "HTTP/2").
+    quoneq_http_timing timing                   = {};   ///< Timing breakdown of the transfer.
+    size_t bytesSent                            = 0;    ///< Request header and body bytes sent.
+    size_t bytesReceived                        = 0;    ///< Response header and body bytes received, before content decoding.
+    bool connectionReused                       = false;    ///< Whether the request was sent over an existing connection.
+    quoneq_http_headers header                  = {};   ///< HTTP response header fields.
+    quoneq_http_headers cookies                 = {};   ///< Cookies received in the response, by name.
 } quoneq_http_response;
 
+/**
+ * @brief Timeout and retry policy of an HTTP request.
+ *
+ * A zero timeout or limit leaves the corresponding libcurl default in place,
+ * so a default-constructed policy behaves as requests always have. Retries
+ * apply to buffered requests (get, post and their session counterparts);
+ * downloads and batched requests honour the timeouts only.
+ */
+typedef struct quoneq_http_policy_t {
+    long connectTimeoutMs               = 0;        ///< Maximum time to establish a connection, in milliseconds.
+    long timeoutMs                      = 0;        ///< Maximum time for the whole transfer, in milliseconds.
+    long lowSpeedLimit                  = 0;        ///< Transfer rate, in bytes per second, below which a transfer is considered stalled.
+    long lowSpeedTime                   = 0;        ///< Seconds a transfer may stay below lowSpeedLimit before it is aborted.
+    unsigned maxRetries                 = 0;        ///< Number of retries after the first attempt.
+    long backoffBaseMs                  = 200;      ///< Backoff before the first retry; doubled on every further retry.
+    long backoffMaxMs                   = 30000;    ///< Upper bound of a backoff and of an honoured Retry-After delay.
+    bool retryNonIdempotent             = false;    ///< Whether POST requests are retried as well.
+    std::vector<uint16_t> retryStatuses = { 429, 502, 503, 504 };  ///< HTTP status codes that are retried.
+} quoneq_http_policy;
+
+/**
+ * @brief Counts how often the timeout and retry policies fired.
+ */
+typedef struct quoneq_http_policy_stats_t {
+    size_t connectTimeouts  = 0;    ///< Transfers aborted while connecting.
+    size_t totalTimeouts    = 0;    ///< Transfers aborted by the total timeout.
+    size_t lowSpeedAborts   = 0;    ///< Transfers aborted for being too slow.
+    size_t retries          = 0;    ///< Retries performed.
+    size_t retryAfterWaits  = 0;    ///< Retries delayed by a server's Retry-After.
+    size_t exhausted        = 0;    ///< Requests given up on: retries used up, or Retry-After above backoffMaxMs.
+} quoneq_http_policy_stats;
+
+/**
+ * @brief Describes a single HTTP request.
+ *
+ * This structure bundles every parameter accepted by the quoneq_http_client
+ * methods so that requests can be queued and handed to batch executors such
+ * as quoneq_http_multi.
+ */
+typedef struct quoneq_http_request_t {
+    std::string method                          = "GET";    ///< HTTP method (e.g., "GET", "POST", "HEAD").
+    std::string url                             = "";       ///< The target URL.
+    std::map<std::string, std::string> headers  = {};       ///< Map of HTTP headers to send.
+    std::map<std::string, std::string> cookies  = {};       ///< Map of cookies to send.
+    std::map<std::string, std::string> form     = {};       ///< Map of form fields and values.
+    std::map<std::string, std::string> files    = {};       ///< Map of file form fields and file paths.
+    std::string proxy                           = "";       ///< Proxy server to use.
+    std::string username                        = "";       ///< Username for basic authentication.
+    std::string password                        = "";       ///< Password for basic authentication.
+    bool compressed                             = false;    ///< Negotiate a compressed (gzip, deflate, br or zstd) response.
+    quoneq_http_policy policy                   = {};       ///< Timeout and retry policy.
+} quoneq_http_request;
+
+/**
+ * @brief Receives response body chunks as they arrive.
+ *
+ * The sink is called once per chunk received from the network. It may block
+ * to apply backpressure, since no further data is read from the connection
+ * until it returns. Returning false aborts the transfer.
+ */
+typedef std::function<bool(std::string_view chunk)> quoneq_http_sink;
+
+/**
+ * @brief Represents a raw request body.
+ *
+ * The body is taken from the reader when one is set, and from data
+ * otherwise. A body with a content coding other than identity is compressed
+ * while it is being sent, one chunk at a time.
+ */
+typedef struct quoneq_http_body_t {
+    std::string contentType             = "application/octet-stream";   ///< The Content-Type of the body.
+    std::span<const std::byte> data     = {};                           ///< In-memory body, sent without copying.
+    quoneq_http_source reader           = nullptr;                      ///< Streaming body source, used instead of data when set.
+    quoneq_http_encoding encoding       = quoneq_http_encoding::identity;   ///< Content coding applied to the body.
+    int level                           = 0;                            ///< Compression level; 0 selects the codec's default.
+} quoneq_http_body;
+
+class quoneq_http_cache;
+
 /**
  * @brief HTTP client for performing HTTP operations using libcurl.
  *
@@ -64,39 +427,76 @@ typedef struct quoneq_http_response_t {
 class quoneq_http_client {
 private:
     /**
-     * @brief Callback function used by libcurl to write received data into a string.
+     * @brief Callback function used by libcurl to write received data into a response.
      *
-     * This function appends the data received from libcurl to the provided std::string.
+     * This function appends the data received from libcurl directly to the
+     * response content. On the first chunk, it reserves the capacity announced
+     * by the Content-Length header so that large bodies are not reallocated
+     * repeatedly as they grow.
      *
      * @param contents Pointer to the incoming data.
      * @param size Size of each data element.
      * @param nmemb Number of data elements.
-     * @param output Pointer to the std::string that receives the data.
+     * @param response Pointer to the quoneq_http_response that receives the data.
      * @return The number of bytes processed.
      */
     static size_t write_callback(
         void* contents,
         size_t size,
         size_t nmemb,
-        std::string* output
+        quoneq_http_response* response
+    );
+
+    /**
+     * @brief Destination of a streamed response body.
+     */
+    typedef struct stream_target_t {
+        const quoneq_http_sink* sink        = nullptr;  ///< The sink receiving the data.
+        quoneq_http_response* response      = nullptr;  ///< The response being populated.
+    } stream_target;
+
+    /**
+     * @brief Callback function used by libcurl to forward received data to a sink.
+     *
+     * @param contents Pointer to the incoming data.
+     * @param size Size of each data element.
+     * @param nmemb Number of data elements.
+     * @param target Pointer to the sink and response of the transfer.
+     * @return The number of bytes processed, or 0 if the sink aborted the transfer.
+     */
+    static size_t stream_callback(
+        void* contents,
+        size_t size,
+        size_t nmemb,
+        stream_target* target
     );
 
     /**
-     * @brief Callback function used by libcurl to write received data to a file stream.
+     * @brief Destination of a file download.
+     */
+    typedef struct file_download_t {
+        CURL* curl                  = nullptr;  ///< The handle performing the download.
+        quoneq_file_sink* file      = nullptr;  ///< The sink receiving the data.
+        bool sized                  = false;    ///< Whether the expected size was looked up.
+    } file_download;
+
+    /**
+     * @brief Callback function used by libcurl to write received data to a file.
      *
-     * This function writes the incoming data to an std::ofstream.
+     * On the first chunk, the file is preallocated when the server announced
+     * the size of the body.
      *
      * @param contents Pointer to the incoming data.
      * @param size Size of each data element.
      * @param nmemb Number of data elements.
-     * @param file Pointer to the std::ofstream where the data will be written.
+     * @param download Pointer to the download destination.
      * @return The number of bytes processed.
      */
     static size_t write_file_callback(
         void* contents,
         size_t size,
         size_t nmemb,
-        std::ofstream* file
+        file_download* download
     );
 
     /**
@@ -104,6 +504,10 @@ private:
      *
      * This function is called as header data is received and it extracts
      * the HTTP status and headers, populating the quoneq_http_response object.
+     * Lines are parsed in place without intermediate allocations and
+     * appended to the response's flat header table. Every Set-Cookie field
+     * is added to the cookie table. A new status line (after a redirect or
+     * an interim response) discards the previous headers.
      *
      * @param contents Pointer to the header data.
      * @param size Size of each element.
@@ -118,6 +522,36 @@ private:
         quoneq_http_response* response
     );
 
+    /**
+     * @brief Removes leading and trailing whitespace, including CR and LF.
+     *
+     * @param text The text to trim.
+     * @return A view of the trimmed text.
+     */
+    static std::string_view trim(std::string_view text);
+
+    /**
+     * @brief Parses an HTTP status line such as "HTTP/1.1 404 Not Found".
+     *
+     * @param line The trimmed status line.
+     * @param response The response receiving the status code and text.
+     */
+    static void parse_status_line(
+        std::string_view line,
+        quoneq_http_response* response
+    );
+
+    /**
+     * @brief Parses the value of a Set-Cookie header into the cookie table.
+     *
+     * @param value The trimmed header value.
+     * @param response The response receiving the cookie.
+     */
+    static void parse_cookie(
+        std::string_view value,
+        quoneq_http_response* response
+    );
+
     /**
      * @brief Prepares a libcurl header list from a map of header key-value pairs.
      *
@@ -144,12 +578,466 @@ private:
         const std::map<std::string, std::string>& cookies
     );
 
+    /**
+     * @brief Callback function used by libcurl to read a file part of a form.
+     *
+     * @param buffer Destination buffer.
+     * @param size Size of each data element.
+     * @param nitems Number of data elements.
+     * @param source Pointer to the quoneq_upload_source of the part.
+     * @return The number of bytes read.
+     */
+    static size_t read_source_callback(
+        char* buffer,
+        size_t size,
+        size_t nitems,
+        void* source
+    );
+
+    /**
+     * @brief Callback function used by libcurl to rewind a file part of a form.
+     *
+     * @param source Pointer to the quoneq_upload_source of the part.
+     * @param offset The offset to seek to.
+     * @param origin SEEK_SET, SEEK_CUR or SEEK_END.
+     * @return CURL_SEEKFUNC_OK on success; CURL_SEEKFUNC_FAIL otherwise.
+     */
+    static int seek_source_callback(
+        void* source,
+        curl_off_t offset,
+        int origin
+    );
+
+    /**
+     * @brief Callback function used by libcurl to release a file part of a form.
+     *
+     * @param source Pointer to the quoneq_upload_source of the part.
+     */
+    static void free_source_callback(void* source);
+
+    /**
+     * @brief Source of a raw request body being sent.
+     */
+    typedef struct body_upload_t {
+        quoneq_http_source source               = nullptr;  ///< The plain body.
+        quoneq_body_encoder* encoder            = nullptr;  ///< The compressor, if the body is encoded.
+    } body_upload;
+
+    /**
+     * @brief Callback function used by libcurl to read a raw request body.
+     *
+     * @param buffer Destination buffer.
+     * @param size Size of each data element.
+     * @param nitems Number of data elements.
+     * @param upload Pointer to the body_upload of the transfer.
+     * @return The number of bytes read, or CURL_READFUNC_ABORT if compression failed.
+     */
+    static size_t read_body_callback(
+        char* buffer,
+        size_t size,
+        size_t nitems,
+        body_upload* upload
+    );
+
+    /**
+     * @brief Builds a MIME form from form fields and file uploads.
+     *
+     * Files are memory-mapped and streamed from the mapping; a file that
+     * cannot be mapped is left to libcurl to read.
+     *
+     * @param curl The libcurl handle the form belongs to.
+     * @param form Map of form fields and values.
+     * @param files Map of file form fields and corresponding file paths.
+     * @return A pointer to the curl_mime structure; the caller owns it.
+     */
+    static curl_mime* prepare_form(
+        CURL* curl,
+        const std::map<std::string, std::string>& form,
+        const std::map<std::string, std::string>& files
+    );
+
+    /**
+     * @brief Copies the transfer statistics of a finished request into its response.
+     *
+     * This fills in the wire length, protocol version, timing breakdown,
+     * byte counts and connection reuse of the response.
+     *
+     * @param curl The libcurl easy handle that performed the request.
+     * @param response The response to update.
+     */
+    static void read_transfer_info(
+        CURL* curl,
+        quoneq_http_response* response
+    );
+
+    /**
+     * @brief Applies the timeouts of a policy to a libcurl handle.
+     *
+     * @param curl The libcurl easy handle.
+     * @param policy The policy to apply.
+     */
+    static void apply_policy(CURL* curl, const quoneq_http_policy& policy);
+
+    /**
+     * @brief Counts a transfer aborted by one of the policy's timeouts.
+     *
+     * @param curl The libcurl easy handle that performed the transfer.
+     * @param result The result code of the transfer.
+     * @param policy The policy the transfer ran under.
+     */
+    static void record_timeout(
+        CURL* curl,
+        CURLcode result,
+        const quoneq_http_policy& policy
+    );
+
+    /**
+     * @brief Decides whether a failed attempt is retried, and after how long.
+     *
+     * @param request The request descriptor.
+     * @param response The response of the attempt.
+     * @param result The result code of the attempt.
+     * @param attempt Number of retries already performed.
+     * @param delay_ms Receives the delay before the retry, in milliseconds.
+     * @return True if the request should be retried; false otherwise.
+     */
+    static bool retry_delay(
+        const quoneq_http_request& request,
+        const quoneq_http_response& response,
+        CURLcode result,
+        unsigned attempt,
+        long* delay_ms
+    );
+
+    /**
+     * @brief Picks the backoff before a retry.
+     *
+     * Exponential backoff with full jitter, bounded by the policy's
+     * backoffMaxMs.
+     *
+     * @param policy The policy the request runs under.
+     * @param attempt Number of retries already performed.
+     * @return The delay before the retry, in milliseconds.
+     */
+    static long backoff_delay(const quoneq_http_policy& policy, unsigned attempt);
+
+    /**
+     * @brief Applies a request descriptor to a libcurl handle.
+     *
+     * This function sets the URL, method, header callback, headers, cookies,
+     * form data, proxy, authentication, compression and timeouts of the request. The body write
+     * callback is left to the caller. The header list and MIME structure it
+     * allocates must be released once the transfer has completed.
+     *
+     * @param curl The libcurl easy handle to configure.
+     * @param request The request descriptor.
+     * @param response The response object the header callback populates.
+     * @param header_list Receives the allocated header list, or nullptr.
+     * @param mime Receives the allocated MIME structure, or nullptr.
+     */
+    static void prepare_request(
+        CURL* curl,
+        const quoneq_http_request& request,
+        quoneq_http_response* response,
+        struct curl_slist** header_list,
+        curl_mime** mime
+    );
+
+    /**
+     * @brief Performs a request on an existing libcurl handle.
+     *
+     * The handle is expected to be freshly initialized or reset. It is
+     * not cleaned up, so callers may keep it (and its connection cache)
+     * alive for subsequent requests.
+     *
+     * Failed attempts are retried on the same handle as the request's
+     * policy allows.
+     *
+     * @param curl The libcurl easy handle to perform the request on.
+     * @param request The request descriptor.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    static std::unique_ptr<quoneq_http_response> perform(
+        CURL* curl,
+        const quoneq_http_request& request
+    );
+
+    /**
+     * @brief Performs a request on an existing libcurl handle, streaming the body.
+     *
+     * @param curl The libcurl easy handle to perform the request on.
+     * @param request The request descriptor.
+     * @param sink The sink receiving the response body.
+     * @return A unique pointer to a quoneq_http_response with an empty content.
+     */
+    static std::unique_ptr<quoneq_http_response> perform_stream(
+        CURL* curl,
+        const quoneq_http_request& request,
+        const quoneq_http_sink& sink
+    );
+
+    /**
+     * @brief Sends a raw request body on an existing libcurl handle.
+     *
+     * @param curl The libcurl easy handle to perform the request on.
+     * @param request The request descriptor; its method, form and files are ignored.
+     * @param body The body to send.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    static std::unique_ptr<quoneq_http_response> perform_body(
+        CURL* curl,
+        const quoneq_http_request& request,
+        const quoneq_http_body& body
+    );
+
+    /**
+     * @brief Pings a URL on an existing libcurl handle.
+     *
+     * @param curl The libcurl easy handle to perform the request on.
+     * @param request The request descriptor; its method is ignored.
+     * @return A unique pointer to a quoneq_http_response containing the ping response.
+     */
+    static std::unique_ptr<quoneq_http_response> perform_ping(
+        CURL* curl,
+        const quoneq_http_request& request
+    );
+
+    /**
+     * @brief Downloads a file on an existing libcurl handle.
+     *
+     * @param curl The libcurl easy handle to perform the request on.
+     * @param request The request descriptor.
+     * @param out_filename The local filename where the downloaded file will be saved.
+     * @param sink_options Buffering and I/O options of the output file.
+     * @return A unique pointer to a quoneq_http_response containing the file download response.
+     */
+    static std::unique_ptr<quoneq_http_response> perform_download_file(
+        CURL* curl,
+        const quoneq_http_request& request,
+        const std::string& out_filename,
+        const quoneq_file_sink_options& sink_options
+    );
+
+    /**
+     * @brief State of one byte range of a segmented download.
+     */
+    typedef struct download_segment_t {
+        CURL* curl                      = nullptr;  ///< The easy handle fetching the range.
+        int fd                          = -1;       ///< Descriptor of the preallocated output file.
+        size_t offset                   = 0;        ///< Next byte offset to be written.
+        size_t last                     = 0;        ///< Inclusive last byte offset of the range.
+        size_t attempts                 = 0;        ///< Number of attempts made so far.
+        struct curl_slist* header_list  = nullptr;  ///< Request header list to release.
+        curl_mime* mime                 = nullptr;  ///< Request MIME structure to release.
+        quoneq_http_response response   = {};       ///< Status and headers of the current attempt.
+        std::chrono::steady_clock::time_point retryAt = {};  ///< Earliest start of the next attempt.
+    } download_segment;
+
+    /**
+     * @brief Callback function that writes a segment's data at its file offset.
+     *
+     * Data is only accepted from a 206 Partial Content response and only
+     * within the segment's range; anything else aborts the attempt.
+     *
+     * @param contents Pointer to the incoming data.
+     * @param size Size of each data element.
+     * @param nmemb Number of data elements.
+     * @param segment Pointer to the segment being fetched.
+     * @return The total number of bytes processed.
+     */
+    static size_t segment_write_callback(
+        void* contents,
+        size_t size,
+        size_t nmemb,
+        download_segment* segment
+    );
+
+    /**
+     * @brief Configures a segment's handle to fetch its remaining range.
+     *
+     * @param segment The segment to (re)start.
+     * @param request The request descriptor shared by all segments.
+     */
+    static void prepare_segment(
+        download_segment* segment,
+        const quoneq_http_request& request
+    );
+
+    /**
+     * @brief Downloads a file as concurrent byte ranges on an existing libcurl handle.
+     *
+     * The handle is used to probe the resource with a HEAD request carrying
+     * the same headers, cookies, credentials and timeouts as the download.
+     * Servers that do not advertise byte ranges, or resources too small to
+     * be worth splitting, are downloaded over a single connection instead.
+     * A failed range is retried after the request policy's backoff, while
+     * the other ranges keep transferring.
+     *
+     * @param curl The libcurl easy handle to probe the resource with.
+     * @param request The request descriptor.
+     * @param out_filename The local filename where the downloaded file will be saved.
+     * @param segments The maximum number of ranges fetched concurrently.
+     * @param max_retries The number of times a failed range is retried.
+     * @return A unique pointer to a quoneq_http_response containing the file download response.
+     */
+    static std::unique_ptr<quoneq_http_response> perform_download_segmented(
+        CURL* curl,
+        const quoneq_http_request& request,
+        const std::string& out_filename,
+        size_t segments,
+        size_t max_retries
+    );
+
+    /**
+     * @brief Progress of a resumable download, persisted next to the output file.
+     */
+    typedef struct download_checkpoint_t {
+        std::string url             = "";   ///< URL the partial file was fetched from.
+        std::string etag            = "";   ///< ETag of the representation being fetched.
+        std::string lastModified    = "";   ///< Last-Modified of the representation being fetched.
+        size_t length               = 0;    ///< Total length of the representation, if known.
+        size_t offset               = 0;    ///< Number of bytes known to be durably written.
+    } download_checkpoint;
+
+    /**
+     * @brief State of a resumable download while it is being transferred.
+     */
+    typedef struct resume_download_t {
+        int fd                              = -1;       ///< Descriptor of the output file.
+        size_t offset                       = 0;        ///< Next byte offset to be written.
+        size_t synced                       = 0;        ///< Offset covered by the last checkpoint.
+        bool started                        = false;    ///< Whether the response has been validated.
+        bool discard                        = false;    ///< Whether the body is not part of the file.
+        std::string error                   = "";       ///< Reason the transfer was aborted, if any.
+        std::string checkpoint_path         = "";       ///< Path of the sidecar checkpoint.
+        download_checkpoint checkpoint      = {};       ///< Checkpoint being maintained.
+        quoneq_http_response* response      = nullptr;  ///< Response receiving the headers.
+    } resume_download;
+
+    /**
+     * @brief Reads a download checkpoint from disk.
+     *
+     * @param path Path of the checkpoint file.
+     * @param checkpoint Receives the checkpoint.
+     * @return True if a checkpoint was read; false otherwise.
+     */
+    static bool load_checkpoint(
+        const std::string& path,
+        download_checkpoint* checkpoint
+    );
+
+    /**
+     * @brief Atomically replaces a download checkpoint on disk.
+     *
+     * @param path Path of the checkpoint file.
+     * @param checkpoint The checkpoint to write.
+     */
+    static void save_checkpoint(
+        const std::string& path,
+        const download_checkpoint& checkpoint
+    );
+
+    /**
+     * @brief Callback function that appends a resumable download to its file.
+     *
+     * The first chunk of the body decides how the response is used: a 206
+     * continues at the checkpointed offset, a 200 restarts the file from
+     * scratch, and any other status is discarded.
+     *
+     * @param contents Pointer to the incoming data.
+     * @param size Size of each data element.
+     * @param nmemb Number of data elements.
+     * @param download Pointer to the download state.
+     * @return The total number of bytes processed.
+     */
+    static size_t resume_write_callback(
+        void* contents,
+        size_t size,
+        size_t nmemb,
+        resume_download* download
+    );
+
+    /**
+     * @brief Downloads a file resumably on an existing libcurl handle.
+     *
+     * @param curl The libcurl easy handle to perform the request on.
+     * @param request The request descriptor.
+     * @param out_filename The local filename where the downloaded file will be saved.
+     * @return A unique pointer to a quoneq_http_response containing the file download response.
+     */
+    static std::unique_ptr<quoneq_http_response> perform_download_resumable(
+        CURL* curl,
+        const quoneq_http_request& request,
+        const std::string& out_filename
+    );
+
+    /**
+     * @brief State of an asynchronous request running on the event loop.
+     */
+    typedef struct async_request_t {
+        CURL* curl                                      = nullptr;  ///< The easy handle running the transfer.
+        std::unique_ptr<quoneq_http_response> response  = nullptr;  ///< The response being populated.
+        struct curl_slist* header_list                  = nullptr;  ///< Request header list to release.
+        curl_mime* mime                                 = nullptr;  ///< Request MIME structure to release.
+        std::promise<std::unique_ptr<quoneq_http_response>> promise{};  ///< Fulfilled on completion.
+    } async_request;
+
+    static std::shared_ptr<quoneq_http_cache> response_cache;  ///< The cache consulted by get(), if any.
+    static std::mutex cache_lock;                               ///< Guards response_cache.
+
+    typedef std::shared_future<std::shared_ptr<const quoneq_http_response>> flight;
+
+    /**
+     * @brief Process-wide policy counters.
+     */
+    typedef struct policy_counters_t {
+        std::atomic<size_t> connectTimeouts{0}; ///< Transfers aborted while connecting.
+        std::atomic<size_t> totalTimeouts{0};   ///< Transfers aborted by the total timeout.
+        std::atomic<size_t> lowSpeedAborts{0};  ///< Transfers aborted for being too slow.
+        std::atomic<size_t> retries{0};         ///< Retries performed.
+        std::atomic<size_t> retryAfterWaits{0}; ///< Retries delayed by Retry-After.
+        std::atomic<size_t> exhausted{0};       ///< Requests failing after every retry.
+    } policy_counters;
+
+    static policy_counters counters;    ///< How often the policies fired.
+
+    static std::map<std::string, flight> flights;   ///< GET requests in flight, by coalescing key.
+    static std::mutex flight_lock;                  ///< Guards flights.
+    static std::atomic<bool> coalescing;            ///< Whether get() coalesces identical requests.
+
+    /**
+     * @brief Performs a GET request, consulting the response cache if one is installed.
+     *
+     * @param request The request descriptor.
+     * @return A unique pointer to a quoneq_http_response, or nullptr if no handle could be created.
+     */
+    static std::unique_ptr<quoneq_http_response> fetch(const quoneq_http_request& request);
+
+    /**
+     * @brief Performs a GET request, sharing the transfer with identical concurrent requests.
+     *
+     * The first caller for a key performs the request; callers arriving
+     * while it is in flight wait for it and receive the same response, or
+     * the exception it failed with. The flight is retired either way.
+     *
+     * @param request The request descriptor.
+     * @return A shared pointer to the immutable response, or nullptr if no handle could be created.
+     */
+    static std::shared_ptr<const quoneq_http_response> fetch_coalesced(
+        const quoneq_http_request& request
+    );
+
+    friend class quoneq_http_multi;
+    friend class quoneq_http_session;
+
 public:
     /**
      * @brief Sends an HTTP GET request.
      *
      * This method performs an HTTP GET request to the specified URL, with optional custom headers,
-     * cookies, proxy, and basic authentication.
+     * cookies, proxy, and basic authentication. When a response cache is installed, fresh cached
+     * responses are returned without a transfer and stale ones are revalidated. When coalescing
+     * is enabled, identical concurrent requests share a single transfer.
      *
      * @param url The target URL.
      * @param headers (Optional) Map of HTTP headers to include in the request.
@@ -157,6 +1045,8 @@ public:
      * @param proxy (Optional) Proxy server to use.
      * @param username (Optional) Username for basic authentication.
      * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @param policy (Optional) Timeout and retry policy of the request.
      * @return A unique pointer to a quoneq_http_response containing the response.
      */
     static std::unique_ptr<quoneq_http_response> get(
@@ -165,9 +1055,75 @@ public:
         const std::map<std::string, std::string>& cookies = {}, 
         const std::string& proxy = "", 
         const std::string& username = "", 
-        const std::string& password = ""
+        const std::string& password = "",
+        bool compressed = false,
+        const quoneq_http_policy& policy = {}
     );
 
+    /**
+     * @brief Installs the response cache consulted by get().
+     *
+     * @param cache The cache to use, or nullptr to disable caching.
+     */
+    static void set_cache(std::shared_ptr<quoneq_http_cache> cache);
+
+    /**
+     * @brief Returns the response cache consulted by get().
+     *
+     * @return The installed cache, or nullptr if caching is disabled.
+     */
+    static std::shared_ptr<quoneq_http_cache> get_cache();
+
+    /**
+     * @brief Sends an HTTP GET request, coalescing it with identical concurrent requests.
+     *
+     * Concurrent calls with the same URL, headers, cookies, proxy, credentials,
+     * compression and policy share a single network transfer. Every caller
+     * receives a pointer to the same immutable response, so the body is never
+     * copied. Should the transfer throw, every waiting caller receives the
+     * same exception.
+     *
+     * @param url The target URL.
+     * @param headers (Optional) Map of HTTP headers to include in the request.
+     * @param cookies (Optional) Map of cookies to include in the request.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @param policy (Optional) Timeout and retry policy of the request.
+     * @return A shared pointer to the immutable response.
+     */
+    static std::shared_ptr<const quoneq_http_response> get_shared(
+        const std::string& url,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false,
+        const quoneq_http_policy& policy = {}
+    );
+
+    /**
+     * @brief Enables or disables request coalescing in get().
+     *
+     * When enabled, identical concurrent get() calls share one network
+     * transfer, and each caller receives its own copy of the response.
+     *
+     * @param enabled Whether to coalesce identical requests.
+     */
+    static void set_coalescing(bool enabled);
+
+    /**
+     * @brief Returns how often the timeout and retry policies fired.
+     *
+     * The counters are process-wide and cover every client, session and
+     * batch engine.
+     *
+     * @return A snapshot of the policy counters.
+     */
+    static quoneq_http_policy_stats policy_stats();
+
     /**
      * @brief Sends an HTTP POST request.
      *
@@ -182,6 +1138,8 @@ public:
      * @param proxy (Optional) Proxy server to use.
      * @param username (Optional) Username for basic authentication.
      * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @param policy (Optional) Timeout and retry policy of the request.
      * @return A unique pointer to a quoneq_http_response containing the response.
      */
     static std::unique_ptr<quoneq_http_response> post(
@@ -192,7 +1150,162 @@ public:
         const std::map<std::string, std::string>& files = {},
         const std::string& proxy = "",
         const std::string& username = "",
-        const std::string& password = ""
+        const std::string& password = "",
+        bool compressed = false,
+        const quoneq_http_policy& policy = {}
+    );
+
+    /**
+     * @brief Sends an HTTP POST request with a raw body.
+     *
+     * This method posts the body as is instead of encoding it as a form. An
+     * in-memory body is handed to libcurl without being copied. A body read
+     * from a source or compressed on the fly is sent with chunked transfer
+     * encoding, so neither the plain nor the compressed body is ever held in
+     * memory as a whole.
+     *
+     * @param url The target URL.
+     * @param body The body to send.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    static std::unique_ptr<quoneq_http_response> post_body(
+        const std::string& url,
+        const quoneq_http_body& body,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
+    );
+
+    /**
+     * @brief Sends an HTTP GET request and streams the response body.
+     *
+     * This method behaves like get(), but hands the body to the sink chunk by
+     * chunk as it arrives instead of buffering it, so memory use stays
+     * constant regardless of the response size. The returned response carries
+     * the status, headers and cookies, and an empty content.
+     *
+     * @param url The target URL.
+     * @param sink The sink receiving the response body.
+     * @param headers (Optional) Map of HTTP headers to include in the request.
+     * @param cookies (Optional) Map of cookies to include in the request.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    static std::unique_ptr<quoneq_http_response> get_stream(
+        const std::string& url,
+        const quoneq_http_sink& sink,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
+    );
+
+    /**
+     * @brief Sends an HTTP POST request and streams the response body.
+     *
+     * This method behaves like post(), but hands the body to the sink chunk
+     * by chunk as it arrives instead of buffering it.
+     *
+     * @param url The target URL.
+     * @param sink The sink receiving the response body.
+     * @param form (Optional) Map of form fields and values.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param files (Optional) Map of file form fields and corresponding file paths.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    static std::unique_ptr<quoneq_http_response> post_stream(
+        const std::string& url,
+        const quoneq_http_sink& sink,
+        const std::map<std::string, std::string>& form = {},
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::map<std::string, std::string>& files = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
+    );
+
+    /**
+     * @brief Sends an HTTP request asynchronously.
+     *
+     * The request is prepared on the calling thread and performed by the
+     * internal event loop, so the caller is not blocked for the duration of
+     * the network round trip. The future yields nullptr if no libcurl handle
+     * could be allocated, like the blocking methods.
+     *
+     * @param request The request descriptor.
+     * @return A future resolving to the response once the transfer completes.
+     */
+    static std::future<std::unique_ptr<quoneq_http_response>> request_async(
+        const quoneq_http_request& request
+    );
+
+    /**
+     * @brief Sends an HTTP GET request asynchronously.
+     *
+     * @param url The target URL.
+     * @param headers (Optional) Map of HTTP headers to include in the request.
+     * @param cookies (Optional) Map of cookies to include in the request.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A future resolving to the response once the transfer completes.
+     */
+    static std::future<std::unique_ptr<quoneq_http_response>> get_async(
+        const std::string& url,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
+    );
+
+    /**
+     * @brief Sends an HTTP POST request asynchronously.
+     *
+     * @param url The target URL.
+     * @param form (Optional) Map of form fields and values.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param files (Optional) Map of file form fields and corresponding file paths.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A future resolving to the response once the transfer completes.
+     */
+    static std::future<std::unique_ptr<quoneq_http_response>> post_async(
+        const std::string& url,
+        const std::map<std::string, std::string>& form = {},
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::map<std::string, std::string>& files = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
     );
 
     /**
@@ -230,6 +1343,8 @@ public:
      * @param proxy (Optional) Proxy server to use.
      * @param username (Optional) Username for basic authentication.
      * @param password (Optional) Password for basic authentication.
+     * @param sink_options (Optional) Buffering and I/O options of the output file.
+     * @param policy (Optional) Timeout policy of the download; retries are not applied.
      * @return A unique pointer to a quoneq_http_response containing the file download response.
      */
     static std::unique_ptr<quoneq_http_response> download_file(
@@ -241,6 +1356,76 @@ public:
         const std::map<std::string, std::string>& files = {},
         const std::string& proxy = "",
         const std::string& username = "",
+        const std::string& password = "",
+        const quoneq_file_sink_options& sink_options = {},
+        const quoneq_http_policy& policy = {}
+    );
+
+    /**
+     * @brief Downloads a file from the specified URL as concurrent byte ranges.
+     *
+     * The resource is probed with a HEAD request carrying the given headers,
+     * cookies and credentials; when the server answers with a Content-Length
+     * and "Accept-Ranges: bytes", the output file is preallocated and split
+     * into ranges that are fetched in parallel and written straight to their
+     * offsets. A range that fails is resumed from its last written byte up
+     * to max_retries times, each after the default policy's jittered
+     * exponential backoff. Otherwise the file is
+     * downloaded over a single connection, as with download_file().
+     *
+     * @param url The URL of the file to download.
+     * @param out_filename The local filename where the downloaded file will be saved.
+     * @param segments (Optional) Maximum number of ranges fetched concurrently.
+     * @param max_retries (Optional) Number of times a failed range is retried.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @return A unique pointer to a quoneq_http_response containing the file download response.
+     */
+    static std::unique_ptr<quoneq_http_response> download_file_segmented(
+        const std::string& url,
+        const std::string& out_filename,
+        size_t segments = 4,
+        size_t max_retries = 3,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = ""
+    );
+
+    /**
+     * @brief Downloads a file from the specified URL, resuming an interrupted download.
+     *
+     * Progress is recorded in a sidecar checkpoint named after the output
+     * file with a ".resume" suffix, holding the URL, the ETag/Last-Modified
+     * validators and the number of bytes known to be on disk. When a
+     * checkpoint for the same URL exists, the partial file is trimmed to the
+     * checkpointed size and only the remainder is requested with Range and
+     * If-Range. Should the resource have changed, the server sends it in full
+     * and the file is rewritten from the start. Without a checkpoint, any
+     * existing file is overwritten. The checkpoint is removed once the
+     * download completes.
+     *
+     * @param url The URL of the file to download.
+     * @param out_filename The local filename where the downloaded file will be saved.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @return A unique pointer to a quoneq_http_response containing the file download
+     *         response; its status is 206 when an earlier download was continued.
+     */
+    static std::unique_ptr<quoneq_http_response> download_file_resumable(
+        const std::string& url,
+        const std::string& out_filename,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
         const std::string& password = ""
     );
 };
@@ -0,0 +1,265 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_http_cache.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides an in-process HTTP response cache.
+ *
+ * This header defines the quoneq_http_cache class, a memory-bounded LRU cache
+ * of HTTP responses with optional disk backing. It follows the freshness
+ * rules of Cache-Control and Expires, and revalidates stale responses with
+ * If-None-Match and If-Modified-Since.
+ */
+#ifndef QUONEQ_HTTP_CACHE_HPP
+#define QUONEQ_HTTP_CACHE_HPP
+
+#include <quoneq/http.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Configuration of a response cache.
+ */
+typedef struct quoneq_http_cache_options_t {
+    size_t maxBytes         = 64UL << 20;   ///< Memory budget for cached responses, in bytes.
+    std::string directory   = "";           ///< Directory backing the cache on disk; empty keeps it in memory only.
+} quoneq_http_cache_options;
+
+/**
+ * @brief Counters of a response cache.
+ */
+typedef struct quoneq_http_cache_stats_t {
+    size_t hits             = 0;    ///< Requests served from a fresh cached response.
+    size_t misses           = 0;    ///< Cacheable requests that needed a full transfer.
+    size_t revalidations    = 0;    ///< Stale responses confirmed by a 304 Not Modified.
+    size_t evictions        = 0;    ///< Responses dropped from memory to stay within budget.
+} quoneq_http_cache_stats;
+
+/**
+ * @brief In-process HTTP response cache.
+ *
+ * The cache stores successful GET responses keyed on the URL, credentials,
+ * proxy, cookies, authorization headers and negotiated compression of the
+ * request, and on the request headers named by the response's Vary field. A response is reused while it
+ * is fresh according to Cache-Control max-age or Expires (or, lacking both,
+ * a tenth of its Last-Modified age). Once stale, it is revalidated with the
+ * ETag and Last-Modified it was received with, and a 304 Not Modified is
+ * answered with the cached response. Responses marked no-store or private
+ * are never stored, responses to authenticated requests only when marked
+ * public or s-maxage, and no-cache responses are revalidated on every use.
+ * Passwords, cookies and authorization headers enter the key only hashed,
+ * and cookies set by a response are never stored or replayed.
+ *
+ * Memory use is bounded by evicting the least recently used responses. When
+ * a directory is configured, every stored response is also written there,
+ * so evicted responses and those of previous processes can be reloaded.
+ *
+ * A cache is thread-safe and can be shared by any number of threads.
+ */
+class quoneq_http_cache {
+private:
+    /**
+     * @brief A cached response.
+     */
+    typedef struct entry_t {
+        std::string key                                         = "";   ///< The cache key of the request.
+        quoneq_http_response response                           = {};   ///< The cached response.
+        std::vector<std::pair<std::string, std::string>> vary   = {};   ///< Request header values the response varies on.
+        std::time_t expires                                     = 0;    ///< Time at which the response becomes stale.
+        size_t bytes                                            = 0;    ///< Memory accounted to the entry.
+    } entry;
+
+    quoneq_http_cache_options options;  ///< The configuration of the cache.
+    mutable std::mutex lock;            ///< Guards every member below.
+    std::list<entry> entries;           ///< Cached responses, most recently used first.
+    std::unordered_map<std::string, std::list<entry>::iterator> index;  ///< Entries by cache key.
+    size_t bytes;                       ///< Memory accounted to all entries.
+    quoneq_http_cache_stats counters;   ///< Hit, miss and revalidation counters.
+
+    /**
+     * @brief Builds the cache key of a request.
+     *
+     * @param request The request descriptor.
+     * @return The key, or an empty string if the request must bypass the cache.
+     */
+    static std::string make_key(const quoneq_http_request& request);
+
+    /**
+     * @brief Computes when a response becomes stale.
+     *
+     * @param header The response header fields.
+     * @param now The time the response was received.
+     * @return The expiry time; not later than now if the response must
+     *         be revalidated before reuse.
+     */
+    static std::time_t freshness(const quoneq_http_headers& header, std::time_t now);
+
+    /**
+     * @brief Checks whether a response may be stored.
+     *
+     * Responses marked no-store or private are never stored, and responses
+     * to authenticated requests only when marked public or s-maxage.
+     *
+     * @param request The request the response answers.
+     * @param response The response to check.
+     * @return True if the response is cacheable; false otherwise.
+     */
+    static bool storable(
+        const quoneq_http_request& request,
+        const quoneq_http_response& response
+    );
+
+    /**
+     * @brief Checks whether a cached response was selected by the same header values.
+     *
+     * @param cached The cached entry.
+     * @param request The request being served.
+     * @return True if every varying header matches; false otherwise.
+     */
+    static bool vary_matches(const entry& cached, const quoneq_http_request& request);
+
+    /**
+     * @brief Returns the file backing a key on disk.
+     *
+     * @param key The cache key.
+     * @return The path of the file.
+     */
+    std::string disk_path(const std::string& key) const;
+
+    /**
+     * @brief Writes an entry to disk, if a directory is configured.
+     *
+     * @param cached The entry to write.
+     */
+    void save(const entry& cached) const;
+
+    /**
+     * @brief Reads an entry from disk, if a directory is configured.
+     *
+     * @param key The cache key.
+     * @param cached The entry to populate.
+     * @return True if a matching entry was read; false otherwise.
+     */
+    bool load(const std::string& key, entry* cached) const;
+
+    /**
+     * @brief Finds an entry in memory or on disk and marks it as most recently used.
+     *
+     * Must be called with the lock held.
+     *
+     * @param key The cache key.
+     * @return An iterator to the entry, or the end of the entry list if absent.
+     */
+    std::list<entry>::iterator find(const std::string& key);
+
+    /**
+     * @brief Inserts or replaces an entry in memory, evicting as needed.
+     *
+     * Must be called with the lock held.
+     *
+     * @param cached The entry to insert.
+     */
+    void insert(entry cached);
+
+    /**
+     * @brief Removes an entry from memory and disk.
+     *
+     * Must be called with the lock held.
+     *
+     * @param key The cache key.
+     */
+    void erase(const std::string& key);
+
+public:
+    /**
+     * @brief Creates a new response cache.
+     *
+     * @param cache_options (Optional) The configuration of the cache.
+     */
+    explicit quoneq_http_cache(const quoneq_http_cache_options& cache_options = {});
+
+    quoneq_http_cache(const quoneq_http_cache&) = delete;
+    quoneq_http_cache& operator=(const quoneq_http_cache&) = delete;
+
+    /**
+     * @brief Looks up the response to a request.
+     *
+     * If a fresh response is cached, a copy of it is returned. Otherwise the
+     * validators of a stale cached response, if any, are added to the
+     * conditional request, which should then be performed and its response
+     * passed to update().
+     *
+     * @param request The request being served.
+     * @param conditional The request to perform on a miss; should start as a copy of request.
+     * @return A copy of the cached response, or nullptr on a miss.
+     */
+    std::unique_ptr<quoneq_http_response> lookup(
+        const quoneq_http_request& request,
+        quoneq_http_request* conditional
+    );
+
+    /**
+     * @brief Records the response to a request performed after a miss.
+     *
+     * A 304 Not Modified refreshes the cached response and is replaced by a
+     * copy of it. If the cached response was evicted in the meantime, the
+     * 304 is returned unchanged and the request should be repeated without
+     * the validators lookup() added. Any other response is stored if it is
+     * cacheable. Cookies set by a response are handed to this caller only;
+     * they are never stored, persisted or replayed.
+     *
+     * @param request The request being served.
+     * @param response The response received from the network.
+     * @return The response to hand to the caller.
+     */
+    std::unique_ptr<quoneq_http_response> update(
+        const quoneq_http_request& request,
+        std::unique_ptr<quoneq_http_response> response
+    );
+
+    /**
+     * @brief Removes every cached response from memory and disk.
+     *
+     * Every .cache file in the configured directory is deleted, including
+     * those written by other processes.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the counters of the cache.
+     *
+     * @return A snapshot of the hit, miss, revalidation and eviction counters.
+     */
+    quoneq_http_cache_stats stats() const;
+};
+
+#endif
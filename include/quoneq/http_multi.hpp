@@ -0,0 +1,133 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_http_multi.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides a concurrent HTTP request engine based on libcurl's multi interface.
+ *
+ * This header defines the quoneq_http_multi class, which drives a batch of
+ * HTTP requests from a single event loop instead of one thread per request.
+ */
+#ifndef QUONEQ_HTTP_MULTI_HPP
+#define QUONEQ_HTTP_MULTI_HPP
+
+#include <quoneq/http.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Concurrent HTTP request engine.
+ *
+ * The quoneq_http_multi class executes a batch of quoneq_http_request
+ * descriptors concurrently on the calling thread using curl_multi. The number
+ * of transfers in flight and the number of connections per host are bounded.
+ * Easy handles and the connection cache are kept between batches, so
+ * subsequent batches to the same hosts reuse existing connections.
+ *
+ * When HTTP/2 is enabled, it is negotiated over TLS and concurrent requests
+ * to the same origin are multiplexed as streams over a shared connection
+ * instead of each opening a connection of its own.
+ *
+ * An engine is not thread-safe; use one engine per thread.
+ */
+class quoneq_http_multi {
+private:
+    /**
+     * @brief State of a single in-flight transfer.
+     */
+    typedef struct transfer_t {
+        size_t index                                    = 0;        ///< Position of the request in the batch.
+        CURL* curl                                      = nullptr;  ///< The easy handle running the transfer.
+        std::unique_ptr<quoneq_http_response> response  = nullptr;  ///< The response being populated.
+        struct curl_slist* header_list                  = nullptr;  ///< Request header list to release.
+        curl_mime* mime                                 = nullptr;  ///< Request MIME structure to release.
+        const quoneq_http_policy* policy                = nullptr;  ///< Timeout policy of the request.
+    } transfer;
+
+    CURLM* multi;               ///< The libcurl multi handle driving all transfers.
+    size_t in_flight_limit;     ///< Maximum number of concurrent transfers.
+    bool multiplex;             ///< Whether HTTP/2 is negotiated and multiplexed.
+    std::vector<CURL*> idle;    ///< Easy handles available for reuse.
+
+    /**
+     * @brief Starts the transfer of a request.
+     *
+     * @param request The request descriptor.
+     * @param index Position of the request in the batch.
+     * @return The started transfer, or a transfer without a handle if
+     *         no easy handle could be allocated.
+     */
+    std::unique_ptr<transfer> start(
+        const quoneq_http_request& request,
+        size_t index
+    );
+
+    /**
+     * @brief Completes a transfer and returns its handle to the idle pool.
+     *
+     * @param task The transfer to complete.
+     * @param result The result code reported by libcurl.
+     */
+    void finish(transfer* task, CURLcode result);
+
+public:
+    /**
+     * @brief Creates a new multi-request engine.
+     *
+     * @param max_in_flight (Optional) Maximum number of concurrent transfers.
+     * @param max_per_host (Optional) Maximum number of connections per host.
+     * @param http2 (Optional) Whether to negotiate HTTP/2 over TLS and multiplex requests.
+     * @param max_streams (Optional) Maximum number of concurrent streams per HTTP/2 connection.
+     */
+    explicit quoneq_http_multi(
+        size_t max_in_flight = 16,
+        long max_per_host = 6L,
+        bool http2 = true,
+        long max_streams = 100L
+    );
+
+    /**
+     * @brief Destroys the engine, its easy handles and its connections.
+     */
+    ~quoneq_http_multi();
+
+    quoneq_http_multi(const quoneq_http_multi&) = delete;
+    quoneq_http_multi& operator=(const quoneq_http_multi&) = delete;
+
+    /**
+     * @brief Performs a batch of HTTP requests concurrently.
+     *
+     * This method blocks until every request in the batch has completed.
+     * Requests that fail carry their error in the response's errorMessage.
+     *
+     * @param requests The request descriptors to perform.
+     * @return One response per request, in the same order as the requests.
+     */
+    std::vector<std::unique_ptr<quoneq_http_response>> perform(
+        const std::vector<quoneq_http_request>& requests
+    );
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_http_session.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides a persistent, connection-reusing HTTP session.
+ *
+ * This header defines the quoneq_http_session class, which keeps a single
+ * libcurl handle alive across requests so that DNS lookups, TCP connections
+ * and TLS sessions are reused for subsequent calls to the same host.
+ */
+#ifndef QUONEQ_HTTP_SESSION_HPP
+#define QUONEQ_HTTP_SESSION_HPP
+
+#include <quoneq/http.hpp>
+
+#include <cstddef>
+
+/**
+ * @brief Stateful HTTP client that reuses its connections.
+ *
+ * Unlike quoneq_http_client, whose static methods create and destroy a
+ * libcurl handle on every call, a quoneq_http_session owns one handle for its
+ * whole lifetime. The handle is reset between requests, which clears the
+ * request options but keeps the connection cache, so keep-alive connections
+ * are picked up again by the next request to the same host.
+ *
+ * A session is not thread-safe; use one session per thread.
+ */
+class quoneq_http_session {
+private:
+    CURL* curl;                 ///< The persistent libcurl easy handle.
+    long connection_limit;      ///< Size of the handle's connection cache.
+    size_t requests;            ///< Number of requests performed.
+    size_t reused;              ///< Number of requests served over a reused connection.
+    quoneq_http_policy policy;  ///< Timeout and retry policy applied to every request.
+
+    /**
+     * @brief Resets the handle before a new request.
+     *
+     * Clears the options of the previous request while keeping the
+     * connection cache intact, then applies the session-wide options.
+     */
+    void prepare();
+
+    /**
+     * @brief Updates the connection statistics after a request.
+     *
+     * A request counts as reused when it received a response without
+     * libcurl having to open a new connection.
+     */
+    void track();
+
+public:
+    /**
+     * @brief Creates a new HTTP session.
+     *
+     * @param max_connections (Optional) Maximum number of idle connections kept alive.
+     */
+    explicit quoneq_http_session(long max_connections = 8L);
+
+    /**
+     * @brief Destroys the session and closes all of its connections.
+     */
+    ~quoneq_http_session();
+
+    quoneq_http_session(const quoneq_http_session&) = delete;
+    quoneq_http_session& operator=(const quoneq_http_session&) = delete;
+
+    /**
+     * @brief Sends an HTTP GET request over the session.
+     *
+     * @param url The target URL.
+     * @param headers (Optional) Map of HTTP headers to include in the request.
+     * @param cookies (Optional) Map of cookies to include in the request.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    std::unique_ptr<quoneq_http_response> get(
+        const std::string& url,
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
+    );
+
+    /**
+     * @brief Sends an HTTP POST request over the session.
+     *
+     * @param url The target URL.
+     * @param form (Optional) Map of form fields and values.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param files (Optional) Map of file form fields and corresponding file paths.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
+     * @return A unique pointer to a quoneq_http_response containing the response.
+     */
+    std::unique_ptr<quoneq_http_response> post(
+        const std::string& url,
+        const std::map<std::string, std::string>& form = {},
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::map<std::string, std::string>& files = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        bool compressed = false
+    );
+
+    /**
+     * @brief Pings a URL over the session.
+     *
+     * @param url The target URL to ping.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @return A unique pointer to a quoneq_http_response containing the ping response.
+     */
+    std::unique_ptr<quoneq_http_response> ping(
+        const std::string& url,
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = ""
+    );
+
+    /**
+     * @brief Downloads a file over the session.
+     *
+     * @param url The URL of the file to download.
+     * @param out_filename The local filename where the downloaded file will be saved.
+     * @param form (Optional) Map of form fields and values.
+     * @param headers (Optional) Map of HTTP headers.
+     * @param cookies (Optional) Map of cookies.
+     * @param files (Optional) Map of file form fields and corresponding file paths.
+     * @param proxy (Optional) Proxy server to use.
+     * @param username (Optional) Username for basic authentication.
+     * @param password (Optional) Password for basic authentication.
+     * @param sink_options (Optional) Buffering and I/O options of the output file.
+     * @return A unique pointer to a quoneq_http_response containing the file download response.
+     */
+    std::unique_ptr<quoneq_http_response> download_file(
+        const std::string& url,
+        const std::string& out_filename,
+        const std::map<std::string, std::string>& form = {},
+        const std::map<std::string, std::string>& headers = {},
+        const std::map<std::string, std::string>& cookies = {},
+        const std::map<std::string, std::string>& files = {},
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        const quoneq_file_sink_options& sink_options = {}
+    );
+
+    /**
+     * @brief Sets the timeout and retry policy applied to every request of the session.
+     *
+     * @param session_policy The policy to apply.
+     */
+    void set_policy(const quoneq_http_policy& session_policy);
+
+    /**
+     * @brief Returns the number of requests performed by this session.
+     *
+     * @return The total request count.
+     */
+    size_t request_count() const;
+
+    /**
+     * @brief Returns the number of requests that reused an existing connection.
+     *
+     * Comparing this against request_count() shows whether keep-alive is
+     * effective for the hosts being contacted.
+     *
+     * @return The number of requests served without opening a new connection.
+     */
+    size_t reused_connection_count() const;
+};
+
+#endif
@@ -33,8 +33,13 @@
 #ifndef QUONEQ_NET_HPP
 #define QUONEQ_NET_HPP
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
+#include <curl/curl.h>
+
 /**
  * @brief Network utility class.
  *
@@ -44,14 +49,85 @@
  */
 class quoneq_net {
 private:
+    /**
+     * @brief Resolved CA certificate configuration.
+     *
+     * Instances are immutable once published. Handles point into the PEM
+     * bundle without copying it, so every handle keeps the store it uses
+     * alive through its binding until cleanup_handle() releases it.
+     */
+    typedef struct ca_store_t {
+        std::string path    = "";       ///< Resolved CA certificate file path.
+        std::string pem     = "";       ///< In-memory CA bundle, empty if unused.
+        bool cached         = false;    ///< Whether the TLS backend caches the parsed CA file.
+    } ca_store;
+
+    /**
+     * @brief CA configuration a handle has been given.
+     */
+    typedef struct ca_binding_t {
+        std::shared_ptr<const ca_store> store   = nullptr;  ///< Store the handle's CA blob points into.
+        bool persistent                         = false;    ///< Whether the handle is reused across transfers.
+    } ca_binding;
+
     static std::string cacert_path;
+    static std::shared_ptr<const ca_store> cacert_store;
+    static std::map<CURL*, ca_binding> ca_bindings;
+    static std::mutex cacert_lock;
+
+    static CURLSH* share;
+    static std::mutex share_locks[CURL_LOCK_DATA_LAST];
+
+    /**
+     * @brief Resolves and caches the CA certificate configuration.
+     *
+     * Uses the path set by set_ca_cert(), or libcurl's built-in default
+     * when none was set. If the TLS backend accepts in-memory CA bundles,
+     * the bundle is read once here, so handshakes no longer read it from
+     * disk. Whether the backend also caches the parsed CA file
+     * (CURLOPT_CA_CACHE_TIMEOUT, OpenSSL and its forks) is recorded as well.
+     */
+    static void load_ca_cert();
+
+    /**
+     * @brief Lock callback installed on the share object.
+     *
+     * Serializes access to the shared data identified by `data` across
+     * threads.
+     *
+     * @param handle The libcurl handle requesting the lock.
+     * @param data The shared data to lock.
+     * @param access The requested access type.
+     * @param userptr User pointer (unused).
+     */
+    static void share_lock(
+        CURL* handle,
+        curl_lock_data data,
+        curl_lock_access access,
+        void* userptr
+    );
+
+    /**
+     * @brief Unlock callback installed on the share object.
+     *
+     * @param handle The libcurl handle releasing the lock.
+     * @param data The shared data to unlock.
+     * @param userptr User pointer (unused).
+     */
+    static void share_unlock(
+        CURL* handle,
+        curl_lock_data data,
+        void* userptr
+    );
 
 public:
     /**
      * @brief Initializes network resources.
      *
      * This function should be called before any network operations are performed.
-     * It initializes any necessary network libraries or settings.
+     * It initializes any necessary network libraries or settings, and creates
+     * the thread-safe share object through which all clients share their DNS
+     * cache and TLS session cache.
      */
     static void init();
 
@@ -59,16 +135,65 @@ public:
      * @brief Cleans up network resources.
      *
      * This function should be called after all network operations are complete.
-     * It releases any resources allocated during network initialization.
+     * It releases any resources allocated during network initialization and
+     * stops the asynchronous event loop, aborting any transfer still running
+     * on it. Sessions and engines holding libcurl handles must be destroyed
+     * first.
      */
     static void cleanup();
 
+    /**
+     * @brief Attaches a libcurl handle to the shared caches.
+     *
+     * Called by every client on its handles so that DNS lookups and TLS
+     * sessions resolved by one request, on any thread, are reused by the
+     * others. Does nothing if init() has not been called.
+     *
+     * @param curl The libcurl easy handle to attach.
+     */
+    static void attach_share(CURL* curl);
+
+    /**
+     * @brief Applies the cached CA certificate configuration to a handle.
+     *
+     * Handles marked with persist_handle() use the CA file path with the TLS
+     * backend's CA cache, when it has one, so the parsed store is reused by
+     * every connection of the session. Other handles point at the shared
+     * in-memory CA bundle without copying it, and fall back to the CA file
+     * path. Leaves libcurl's defaults untouched if nothing has been resolved.
+     * Handles configured here must be released with cleanup_handle().
+     *
+     * @param curl The libcurl easy handle to configure.
+     */
+    static void apply_ca_cert(CURL* curl);
+
+    /**
+     * @brief Marks a handle as reused across many transfers.
+     *
+     * Sessions and engines that keep their handles call this once, so that
+     * apply_ca_cert() prefers the TLS backend's CA cache for them.
+     *
+     * @param curl The libcurl easy handle to mark.
+     */
+    static void persist_handle(CURL* curl);
+
+    /**
+     * @brief Releases a libcurl easy handle configured by apply_ca_cert().
+     *
+     * Drops the handle's reference to the CA store its blob points into,
+     * then cleans the handle up. Does nothing for a null handle.
+     *
+     * @param curl The libcurl easy handle to release.
+     */
+    static void cleanup_handle(CURL* curl);
+
     /**
      * @brief Sets the CA certificate file path.
      *
      * This function allows specifying a custom CA certificate file used for 
      * secure SSL/TLS connections. This should be set before performing 
-     * any network operations that require SSL verification.
+     * any network operations that require SSL verification. If called after
+     * init(), the certificate is resolved and cached again immediately.
      *
      * @param path The file path to the CA certificate.
      */
@@ -78,7 +203,8 @@ public:
      * @brief Retrieves the CA certificate file path.
      *
      * This function returns the CA certificate file path previously set by 
-     * `set_ca_cert()`. If no path has been set, it may return an empty string.
+     * `set_ca_cert()`, or libcurl's default CA file once init() has been
+     * called. If neither is known, it returns an empty string.
      *
      * @return The CA certificate file path.
      */
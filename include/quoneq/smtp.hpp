@@ -32,6 +32,7 @@
 #ifndef QUONEQ_SMTP_HPP
 #define QUONEQ_SMTP_HPP
 
+#include <future>
 #include <string>
 #include <vector>
 
@@ -89,8 +90,9 @@ private:
      * @param message The email message body.
      * @param is_html Set to true if the message is HTML formatted.
      * @param files A vector of file paths for attachments.
+     * @return The MIME structure attached to the handle; the caller frees it after the transfer.
      */
-    static void setup_mime_structure(
+    static curl_mime* setup_mime_structure(
         CURL* curl,
         const std::string& email,
         const std::string& recipient,
@@ -100,6 +102,48 @@ private:
         const std::vector<std::string>& files
     );
 
+    /**
+     * @brief Configures a libcurl handle to send an email.
+     *
+     * @param curl Pointer to the libcurl handle.
+     * @param smtp_server The address of the SMTP server.
+     * @param email The sender's email address.
+     * @param password The sender's email password.
+     * @param recipient The recipient's email address.
+     * @param subject The email subject.
+     * @param message The email message body.
+     * @param is_html Set to true if the message is HTML formatted.
+     * @param files A vector of file paths for attachments.
+     * @param upload The upload state backing a plain payload; must outlive the transfer.
+     * @param recipients Receives the recipient list to free after the transfer.
+     * @param mime Receives the MIME structure to free after the transfer, if any.
+     */
+    static void prepare_email(
+        CURL* curl,
+        const std::string& smtp_server,
+        const std::string& email,
+        const std::string& password,
+        const std::string& recipient,
+        const std::string& subject,
+        const std::string& message,
+        bool is_html,
+        const std::vector<std::string>& files,
+        upload_context* upload,
+        struct curl_slist** recipients,
+        curl_mime** mime
+    );
+
+    /**
+     * @brief State of an asynchronous send running on the event loop.
+     */
+    typedef struct async_email_t {
+        CURL* curl                      = nullptr;  ///< The easy handle running the transfer.
+        upload_context upload           = {0, ""};  ///< Upload state of a plain payload.
+        struct curl_slist* recipients   = nullptr;  ///< Recipient list to release.
+        curl_mime* mime                 = nullptr;  ///< MIME structure to release.
+        std::promise<bool> promise{};               ///< Fulfilled on completion.
+    } async_email;
+
 public:
     /**
      * @brief Sends an email via SMTP.
@@ -128,6 +172,33 @@ public:
         const std::vector<std::string>& files = {}
     );
 
+    /**
+     * @brief Sends an email via SMTP asynchronously.
+     *
+     * The transfer is performed by the internal event loop, leaving the
+     * calling thread free until the future is consulted.
+     *
+     * @param smtp_server The address of the SMTP server.
+     * @param email The sender's email address.
+     * @param password The sender's email password.
+     * @param recipient The recipient's email address.
+     * @param subject The email subject.
+     * @param message The email message body.
+     * @param is_html True if the message body is HTML formatted, false if plain text.
+     * @param files (Optional) A vector of file paths to attach to the email.
+     * @return A future resolving to true if the email was sent successfully; false otherwise.
+     */
+    static std::future<bool> send_email_async(
+        const std::string& smtp_server,
+        const std::string& email,
+        const std::string& password,
+        const std::string& recipient,
+        const std::string& subject,
+        const std::string& message,
+        bool is_html,
+        const std::vector<std::string>& files = {}
+    );
+
     /**
      * @brief Sends a plain text email via SMTP.
      *
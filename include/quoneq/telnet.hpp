@@ -36,6 +36,7 @@
 #include <chrono>
 #include <cstdint>
 #include <fstream>
+#include <future>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -109,6 +110,31 @@ public:
         long timeout = 30L
     );
 
+    /**
+     * @brief Executes one or more Telnet commands asynchronously.
+     *
+     * libcurl's TELNET handler runs its own blocking I/O loop and cannot be
+     * driven by a multi handle, so unlike the other protocol clients this
+     * variant runs the blocking command() on a dedicated thread rather than
+     * on the shared event loop.
+     *
+     * @param url The Telnet URL to connect to.
+     * @param commands A vector of commands to execute on the Telnet server.
+     * @param proxy (Optional) The proxy server to use.
+     * @param username (Optional) Username for authentication.
+     * @param password (Optional) Password for authentication.
+     * @param timeout (Optional) Connection timeout in seconds.
+     * @return A future resolving to the server's response.
+     */
+    static std::future<std::unique_ptr<quoneq_telnet_response>> command_async(
+        const std::string& url,
+        const std::vector<std::string>& commands,
+        const std::string& proxy = "",
+        const std::string& username = "",
+        const std::string& password = "",
+        long timeout = 30L
+    );
+
     /**
      * @brief Connects to a Telnet server and retrieves the initial response.
      *
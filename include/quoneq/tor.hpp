@@ -55,6 +55,7 @@ public:
      * @param cookies (Optional) A map of cookie names and values.
      * @param username (Optional) Username for basic authentication.
      * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
      * @return A unique pointer to a quoneq_http_response containing the response data.
      */
     static std::unique_ptr<quoneq_http_response> get(
@@ -62,7 +63,8 @@ public:
         const std::map<std::string, std::string>& headers = {}, 
         const std::map<std::string, std::string>& cookies = {},
         const std::string& username = "", 
-        const std::string& password = ""
+        const std::string& password = "",
+        bool compressed = false
     );
 
     /**
@@ -79,6 +81,7 @@ public:
      * @param files (Optional) A map of file form field names and their associated file paths.
      * @param username (Optional) Username for basic authentication.
      * @param password (Optional) Password for basic authentication.
+     * @param compressed (Optional) Whether to negotiate a compressed (gzip, deflate, br or zstd) response.
      * @return A unique pointer to a quoneq_http_response containing the response data.
      */
     static std::unique_ptr<quoneq_http_response> post(
@@ -88,7 +91,8 @@ public:
         const std::map<std::string, std::string>& cookies = {},
         const std::map<std::string, std::string>& files = {},
         const std::string& username = "",
-        const std::string& password = ""
+        const std::string& password = "",
+        bool compressed = false
     );
 
     /**
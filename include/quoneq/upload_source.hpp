@@ -0,0 +1,111 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file quoneq_upload_source.hpp
+ * @author [Nathanne Isip](https://github.com/nthnn)
+ * @brief Provides a memory-backed data source for uploads.
+ *
+ * This header defines the quoneq_upload_source class, which serves upload
+ * data to libcurl either from a memory-mapped local file or from a buffer
+ * already held by the caller.
+ */
+#ifndef QUONEQ_UPLOAD_SOURCE_HPP
+#define QUONEQ_UPLOAD_SOURCE_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+/**
+ * @brief Read-only, seekable source of upload data.
+ *
+ * A file is mapped into memory with MADV_SEQUENTIAL, so reads are served
+ * straight from the page cache without an intermediate stream buffer and
+ * the kernel reads ahead aggressively. A span is served in place and must
+ * outlive the source.
+ */
+class quoneq_upload_source {
+private:
+    const std::byte* base;  ///< First byte of the data.
+    size_t length;          ///< Number of bytes of data.
+    size_t position;        ///< Offset of the next byte to be read.
+    void* mapping;          ///< The file mapping, if the source owns one.
+    bool valid;             ///< Whether the source has data to serve.
+
+public:
+    /**
+     * @brief Maps a local file for reading.
+     *
+     * @param path Path of the file to upload.
+     */
+    explicit quoneq_upload_source(const std::string& path);
+
+    /**
+     * @brief Serves a caller-owned buffer.
+     *
+     * @param data The bytes to upload; they are not copied.
+     */
+    explicit quoneq_upload_source(std::span<const std::byte> data);
+
+    /**
+     * @brief Unmaps the file, if any.
+     */
+    ~quoneq_upload_source();
+
+    quoneq_upload_source(const quoneq_upload_source&) = delete;
+    quoneq_upload_source& operator=(const quoneq_upload_source&) = delete;
+
+    /**
+     * @brief Checks whether the source is usable.
+     *
+     * @return True if the file was mapped or a buffer was given; false otherwise.
+     */
+    bool is_open() const;
+
+    /**
+     * @brief Returns the total number of bytes of the source.
+     *
+     * @return The size of the data.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Copies the next bytes into a buffer.
+     *
+     * @param buffer Destination buffer.
+     * @param capacity Maximum number of bytes to copy.
+     * @return The number of bytes copied; 0 once the end is reached.
+     */
+    size_t read(char* buffer, size_t capacity);
+
+    /**
+     * @brief Moves the read position.
+     *
+     * @param offset The new offset from the start of the data.
+     * @return True if the offset lies within the data; false otherwise.
+     */
+    bool seek(size_t offset);
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/body_encoder.hpp>
+
+#include <zlib.h>
+
+#ifdef QUONEQ_USE_ZSTD
+#include <zstd.h>
+#endif
+
+quoneq_body_encoder::quoneq_body_encoder(
+    quoneq_http_encoding body_encoding,
+    int level
+) :
+    encoding(body_encoding),
+    zlib(nullptr),
+    zstd(nullptr),
+    input(64 * 1024),
+    input_offset(0),
+    input_length(0),
+    input_done(false),
+    finished(false),
+    failed(false) {
+    switch(this->encoding) {
+        case quoneq_http_encoding::gzip: {
+            z_stream* stream = new z_stream();
+
+            // A window of 15 + 16 bits selects the gzip wrapper.
+            if(deflateInit2(
+                stream,
+                level == 0 ? Z_DEFAULT_COMPRESSION : level,
+                Z_DEFLATED,
+                15 + 16,
+                8,
+                Z_DEFAULT_STRATEGY
+            ) != Z_OK) {
+                delete stream;
+                break;
+            }
+
+            this->zlib = stream;
+            break;
+        }
+
+        case quoneq_http_encoding::zstd:
+#ifdef QUONEQ_USE_ZSTD
+            this->zstd = ZSTD_createCCtx();
+            if(this->zstd && level != 0)
+                ZSTD_CCtx_setParameter(this->zstd, ZSTD_c_compressionLevel, level);
+#endif
+            break;
+
+        case quoneq_http_encoding::identity:
+        default:
+            break;
+    }
+}
+
+quoneq_body_encoder::~quoneq_body_encoder() {
+    if(this->zlib) {
+        deflateEnd(this->zlib);
+        delete this->zlib;
+    }
+
+#ifdef QUONEQ_USE_ZSTD
+    if(this->zstd)
+        ZSTD_freeCCtx(this->zstd);
+#endif
+}
+
+bool quoneq_body_encoder::is_ready() const {
+    return this->zlib || this->zstd;
+}
+
+bool quoneq_body_encoder::has_failed() const {
+    return this->failed;
+}
+
+size_t quoneq_body_encoder::read(
+    char* output,
+    size_t capacity,
+    const quoneq_http_source& source
+) {
+    size_t produced = 0;
+
+    // Returning 0 ends the upload, so keep going until there is output.
+    while(produced == 0 && !this->finished && !this->failed && this->is_ready()) {
+        if(this->input_offset == this->input_length && !this->input_done) {
+            this->input_length = source(this->input.data(), this->input.size());
+            this->input_offset = 0;
+
+            if(this->input_length == 0)
+                this->input_done = true;
+        }
+
+        if(this->zlib) {
+            this->zlib->next_in = reinterpret_cast<Bytef*>(this->input.data() + this->input_offset);
+            this->zlib->avail_in = static_cast<uInt>(this->input_length - this->input_offset);
+            this->zlib->next_out = reinterpret_cast<Bytef*>(output);
+            this->zlib->avail_out = static_cast<uInt>(capacity);
+
+            int result = deflate(this->zlib, this->input_done ? Z_FINISH : Z_NO_FLUSH);
+            if(result == Z_STREAM_END)
+                this->finished = true;
+            else if(result != Z_OK && result != Z_BUF_ERROR)
+                this->failed = true;
+
+            this->input_offset = this->input_length - this->zlib->avail_in;
+            produced = capacity - this->zlib->avail_out;
+        }
+#ifdef QUONEQ_USE_ZSTD
+        else if(this->zstd) {
+            ZSTD_inBuffer in = {
+                this->input.data() + this->input_offset,
+                this->input_length - this->input_offset,
+                0
+            };
+            ZSTD_outBuffer out = { output, capacity, 0 };
+
+            size_t remaining = ZSTD_compressStream2(
+                this->zstd,
+                &out,
+                &in,
+                this->input_done ? ZSTD_e_end : ZSTD_e_continue
+            );
+
+            if(ZSTD_isError(remaining))
+                this->failed = true;
+            else if(this->input_done && remaining == 0)
+                this->finished = true;
+
+            this->input_offset += in.pos;
+            produced = out.pos;
+        }
+#endif
+    }
+
+    return this->failed ? 0 : produced;
+}
+
+const char* quoneq_body_encoder::token(quoneq_http_encoding body_encoding) {
+    switch(body_encoding) {
+        case quoneq_http_encoding::gzip:
+            return "gzip";
+
+        case quoneq_http_encoding::zstd:
+            return "zstd";
+
+        case quoneq_http_encoding::identity:
+        default:
+            break;
+    }
+
+    return "";
+}
@@ -0,0 +1,146 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/event_loop.hpp>
+
+#include <cstdlib>
+
+std::mutex quoneq_event_loop::lock;
+std::mutex quoneq_event_loop::stop_lock;
+std::thread quoneq_event_loop::worker;
+CURLM* quoneq_event_loop::multi = nullptr;
+bool quoneq_event_loop::stopping = false;
+bool quoneq_event_loop::exit_hooked = false;
+std::vector<std::pair<CURL*, quoneq_event_loop::completion>> quoneq_event_loop::pending = {};
+
+void quoneq_event_loop::run() {
+    std::map<CURL*, completion> active;
+    std::vector<std::pair<CURL*, completion>> submitted;
+
+    while(true) {
+        {
+            std::lock_guard<std::mutex> guard(quoneq_event_loop::lock);
+            if(quoneq_event_loop::stopping)
+                break;
+
+            submitted.swap(quoneq_event_loop::pending);
+        }
+
+        for(auto& task : submitted) {
+            curl_multi_add_handle(quoneq_event_loop::multi, task.first);
+            active.emplace(task.first, std::move(task.second));
+        }
+        submitted.clear();
+
+        int running = 0;
+        curl_multi_perform(quoneq_event_loop::multi, &running);
+
+        CURLMsg* message = nullptr;
+        int queued = 0;
+
+        while((message = curl_multi_info_read(quoneq_event_loop::multi, &queued))) {
+            if(message->msg != CURLMSG_DONE)
+                continue;
+
+            CURL* curl = message->easy_handle;
+            CURLcode result = message->data.result;
+            curl_multi_remove_handle(quoneq_event_loop::multi, curl);
+
+            auto task = active.find(curl);
+            if(task == active.end())
+                continue;
+
+            completion on_complete = std::move(task->second);
+            active.erase(task);
+            on_complete(result);
+        }
+
+        curl_multi_poll(quoneq_event_loop::multi, nullptr, 0, 1000, nullptr);
+    }
+
+    for(auto& task : active) {
+        curl_multi_remove_handle(quoneq_event_loop::multi, task.first);
+        task.second(CURLE_ABORTED_BY_CALLBACK);
+    }
+}
+
+void quoneq_event_loop::submit(CURL* curl, completion on_complete) {
+    {
+        std::lock_guard<std::mutex> guard(quoneq_event_loop::lock);
+
+        if(!quoneq_event_loop::multi) {
+            quoneq_event_loop::multi = curl_multi_init();
+
+            if(quoneq_event_loop::multi) {
+                quoneq_event_loop::stopping = false;
+                quoneq_event_loop::worker = std::thread(quoneq_event_loop::run);
+
+                // A still joinable worker would terminate the process when
+                // destroyed, so the loop is stopped at exit if the program
+                // never calls quoneq_net::cleanup(). Registered after every
+                // static it touches, it also runs before they are destroyed.
+                if(!quoneq_event_loop::exit_hooked)
+                    quoneq_event_loop::exit_hooked = std::atexit(quoneq_event_loop::stop) == 0;
+            }
+        }
+
+        if(quoneq_event_loop::multi) {
+            quoneq_event_loop::pending.emplace_back(curl, std::move(on_complete));
+
+            // Woken while the lock is held so that stop() cannot clean the
+            // multi handle up underneath this call.
+            curl_multi_wakeup(quoneq_event_loop::multi);
+            return;
+        }
+    }
+
+    on_complete(CURLE_FAILED_INIT);
+}
+
+void quoneq_event_loop::stop() {
+    std::lock_guard<std::mutex> serial(quoneq_event_loop::stop_lock);
+    std::vector<std::pair<CURL*, completion>> abandoned;
+
+    {
+        std::lock_guard<std::mutex> guard(quoneq_event_loop::lock);
+        if(!quoneq_event_loop::multi)
+            return;
+
+        quoneq_event_loop::stopping = true;
+        curl_multi_wakeup(quoneq_event_loop::multi);
+    }
+
+    if(quoneq_event_loop::worker.joinable())
+        quoneq_event_loop::worker.join();
+
+    {
+        std::lock_guard<std::mutex> guard(quoneq_event_loop::lock);
+
+        abandoned.swap(quoneq_event_loop::pending);
+        curl_multi_cleanup(quoneq_event_loop::multi);
+        quoneq_event_loop::multi = nullptr;
+    }
+
+    for(auto& task : abandoned)
+        task.second(CURLE_ABORTED_BY_CALLBACK);
+}
@@ -0,0 +1,303 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/file_sink.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Offset and size granularity required by O_DIRECT on common file systems.
+static constexpr size_t block_alignment = 4096;
+
+quoneq_file_sink::quoneq_file_sink(
+    const std::string& path,
+    const quoneq_file_sink_options& options
+) :
+    fd(-1),
+    direct(false),
+    sync_range(options.syncRange),
+    reserved(false),
+    buffer_size(std::max<size_t>(
+        (options.bufferSize + block_alignment - 1) / block_alignment * block_alignment,
+        block_alignment
+    )),
+    position(0),
+    submitted(0),
+    current(nullptr),
+    filled(0),
+    buffers(),
+    idle(),
+    queued(),
+    lock(),
+    ready(),
+    released(),
+    writer(),
+    closing(false),
+    failed(false),
+    message() {
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+#ifdef O_DIRECT
+    if(options.directIo) {
+        this->fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        this->direct = this->fd >= 0;
+    }
+#endif
+
+    if(this->fd < 0)
+        this->fd = ::open(path.c_str(), flags, 0644);
+
+    if(this->fd < 0) {
+        this->fail("Unable to open output file");
+        return;
+    }
+
+    const size_t count = std::max<size_t>(options.bufferCount, 1);
+    for(size_t i = 0; i < count; i++) {
+        char* buffer = static_cast<char*>(
+            std::aligned_alloc(block_alignment, this->buffer_size)
+        );
+
+        if(!buffer)
+            break;
+
+        this->buffers.push_back(buffer);
+        this->idle.push_back(buffer);
+    }
+
+    if(this->buffers.empty()) {
+        ::close(this->fd);
+        this->fd = -1;
+        this->fail("Unable to allocate write buffers");
+    }
+}
+
+quoneq_file_sink::~quoneq_file_sink() {
+    this->close();
+
+    for(char* buffer : this->buffers)
+        std::free(buffer);
+}
+
+bool quoneq_file_sink::is_open() const {
+    return this->fd >= 0;
+}
+
+void quoneq_file_sink::reserve(size_t length) {
+    if(this->fd < 0 || this->reserved || length == 0)
+        return;
+
+    this->reserved = posix_fallocate(
+        this->fd,
+        0,
+        static_cast<off_t>(length)
+    ) == 0;
+}
+
+void quoneq_file_sink::fail(const std::string& reason) {
+    std::lock_guard<std::mutex> guard(this->lock);
+    if(this->message.empty())
+        this->message = reason;
+
+    this->failed = true;
+}
+
+bool quoneq_file_sink::write_block(const block& item) {
+    size_t length = item.length;
+
+    // O_DIRECT transfers whole blocks; the padding is trimmed on close.
+    if(this->direct && length % block_alignment != 0) {
+        size_t padded = (length + block_alignment - 1) / block_alignment * block_alignment;
+        std::memset(item.data + length, 0, padded - length);
+
+        length = padded;
+    }
+
+    size_t written = 0;
+    while(written < length) {
+        ssize_t result = pwrite(
+            this->fd,
+            item.data + written,
+            length - written,
+            static_cast<off_t>(item.offset + written)
+        );
+
+        if(result < 0) {
+            if(errno == EINTR)
+                continue;
+
+            this->fail(std::string("Unable to write output file: ") + std::strerror(errno));
+            return false;
+        }
+
+        written += static_cast<size_t>(result);
+    }
+
+#ifdef SYNC_FILE_RANGE_WRITE
+    if(this->sync_range)
+        sync_file_range(
+            this->fd,
+            static_cast<off_t>(item.offset),
+            static_cast<off_t>(length),
+            SYNC_FILE_RANGE_WRITE
+        );
+#endif
+
+    return true;
+}
+
+void quoneq_file_sink::run() {
+    while(true) {
+        block item;
+        {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->ready.wait(guard, [this] {
+                return !this->queued.empty() || this->closing;
+            });
+
+            if(this->queued.empty())
+                return;
+
+            item = this->queued.front();
+            this->queued.pop_front();
+        }
+
+        if(!this->failed)
+            this->write_block(item);
+
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            this->idle.push_back(item.data);
+        }
+        this->released.notify_one();
+    }
+}
+
+void quoneq_file_sink::submit() {
+    block item;
+    item.data = this->current;
+    item.length = this->filled;
+    item.offset = this->submitted;
+
+    this->submitted += this->filled;
+    this->current = nullptr;
+    this->filled = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->queued.push_back(item);
+    }
+
+    if(!this->writer.joinable())
+        this->writer = std::thread(&quoneq_file_sink::run, this);
+    else this->ready.notify_one();
+}
+
+bool quoneq_file_sink::write(const char* data, size_t length) {
+    if(this->fd < 0 || this->failed)
+        return false;
+
+    while(length > 0) {
+        if(!this->current) {
+            std::unique_lock<std::mutex> guard(this->lock);
+            this->released.wait(guard, [this] {
+                return !this->idle.empty();
+            });
+
+            this->current = this->idle.back();
+            this->idle.pop_back();
+        }
+
+        size_t chunk = std::min(length, this->buffer_size - this->filled);
+        std::memcpy(this->current + this->filled, data, chunk);
+
+        this->filled += chunk;
+        this->position += chunk;
+        data += chunk;
+        length -= chunk;
+
+        if(this->filled == this->buffer_size)
+            this->submit();
+    }
+
+    return !this->failed;
+}
+
+bool quoneq_file_sink::close() {
+    // Already closed, or never opened: report the outcome recorded then.
+    if(this->fd < 0)
+        return !this->failed;
+
+    // Small files never leave the calling thread.
+    if(this->current && this->filled > 0 && !this->writer.joinable()) {
+        block item;
+        item.data = this->current;
+        item.length = this->filled;
+        item.offset = this->submitted;
+
+        if(!this->failed)
+            this->write_block(item);
+    }
+    else if(this->current && this->filled > 0)
+        this->submit();
+
+    if(this->current) {
+        this->idle.push_back(this->current);
+        this->current = nullptr;
+        this->filled = 0;
+    }
+
+    if(this->writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            this->closing = true;
+        }
+
+        this->ready.notify_one();
+        this->writer.join();
+    }
+
+    if((this->direct || this->reserved) &&
+        ftruncate(this->fd, static_cast<off_t>(this->position)) != 0)
+        this->fail("Unable to truncate output file");
+
+    if(::close(this->fd) != 0)
+        this->fail("Unable to close output file");
+
+    this->fd = -1;
+    return !this->failed;
+}
+
+size_t quoneq_file_sink::size() const {
+    return this->position;
+}
+
+std::string quoneq_file_sink::error() {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->message;
+}
@@ -21,11 +21,27 @@
  * THE SOFTWARE.
  */
 
+#include <quoneq/event_loop.hpp>
 #include <quoneq/ftp.hpp>
+#include <quoneq/ftp_session.hpp>
 #include <quoneq/net.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
 #include <curl/curl.h>
-#include <fstream>
+
+size_t quoneq_ftp_client::server_limit = 4;
+std::map<std::string, size_t> quoneq_ftp_client::server_connections = {};
+std::mutex quoneq_ftp_client::server_lock;
+std::condition_variable quoneq_ftp_client::server_available;
+
+std::map<std::string, quoneq_ftp_client::server_features> quoneq_ftp_client::features = {};
+std::mutex quoneq_ftp_client::feature_lock;
 
 size_t quoneq_ftp_client::write_callback(
     void* ptr,
@@ -43,13 +59,21 @@ size_t quoneq_ftp_client::write_file_callback(
     void* ptr,
     size_t size,
     size_t nmemb,
-    std::ofstream* stream
+    file_download* download
 ) {
     size_t total = size * nmemb;
-    stream->write(
-        static_cast<char*>(ptr),
-        static_cast<std::streamsize>(total)
-    );
+
+    if(!download->sized) {
+        curl_off_t length = -1;
+        curl_easy_getinfo(download->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+
+        if(length > 0)
+            download->file->reserve(static_cast<size_t>(length));
+        download->sized = true;
+    }
+
+    if(!download->file->write(static_cast<const char*>(ptr), total))
+        return 0;
 
     return total;
 }
@@ -57,16 +81,22 @@ size_t quoneq_ftp_client::write_file_callback(
 size_t quoneq_ftp_client::read_file_callback(
     void* ptr, size_t size, size_t nmemb, void* userdata
 ) {
-    std::ifstream* stream = static_cast<std::ifstream*>(userdata);
-    if(!stream->good())
-        return 0;
+    quoneq_upload_source* source = static_cast<quoneq_upload_source*>(userdata);
+    return source->read(static_cast<char*>(ptr), size * nmemb);
+}
 
-    stream->read(
-        static_cast<char*>(ptr),
-        static_cast<std::streamsize>(size * nmemb)
-    );
+int quoneq_ftp_client::seek_file_callback(
+    void* userdata,
+    curl_off_t offset,
+    int origin
+) {
+    quoneq_upload_source* source = static_cast<quoneq_upload_source*>(userdata);
+    if(origin != SEEK_SET || offset < 0)
+        return CURL_SEEKFUNC_CANTSEEK;
 
-    return static_cast<size_t>(stream->gcount());
+    return source->seek(static_cast<size_t>(offset))
+        ? CURL_SEEKFUNC_OK
+        : CURL_SEEKFUNC_FAIL;
 }
 
 std::string quoneq_ftp_client::extract_ftp_path(const std::string &ftp_url) {
@@ -83,6 +113,61 @@ std::string quoneq_ftp_client::extract_ftp_path(const std::string &ftp_url) {
     return path;
 }
 
+std::string quoneq_ftp_client::escape_path(const std::string &path) {
+    std::string escaped;
+    size_t start = 0;
+
+    while(true) {
+        size_t end = path.find('/', start);
+        std::string component = path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+
+        if(!component.empty()) {
+            char* encoded = curl_easy_escape(
+                nullptr,
+                component.c_str(),
+                static_cast<int>(component.size())
+            );
+
+            if(encoded) {
+                escaped += encoded;
+                curl_free(encoded);
+            }
+        }
+
+        if(end == std::string::npos)
+            break;
+
+        escaped += '/';
+        start = end + 1;
+    }
+
+    return escaped;
+}
+
+std::string quoneq_ftp_client::unescape_path(const std::string &path) {
+    int length = 0;
+    char* decoded = curl_easy_unescape(
+        nullptr,
+        path.c_str(),
+        static_cast<int>(path.size()),
+        &length
+    );
+
+    if(!decoded)
+        return path;
+
+    std::string plain(decoded, static_cast<size_t>(length));
+    curl_free(decoded);
+
+    return plain;
+}
+
+std::string quoneq_ftp_client::command_path(const std::string &ftp_url) {
+    return quoneq_ftp_client::unescape_path(
+        quoneq_ftp_client::extract_ftp_path(ftp_url)
+    );
+}
+
 std::vector<std::string> quoneq_ftp_client::split_str(
     const std::string &s,
     char delimiter
@@ -99,154 +184,286 @@ std::vector<std::string> quoneq_ftp_client::split_str(
     return elems;
 }
 
-std::vector<std::string> quoneq_ftp_client::get_list_detail(
-    const std::string &ftp_url,
-    const std::string &username,
-    const std::string &password
-) {
-    std::vector<std::string> lines;
-    CURL* curl = curl_easy_init();
+void quoneq_ftp_client::acquire_server_slot(const std::string &server) {
+    std::unique_lock<std::mutex> lock(quoneq_ftp_client::server_lock);
+    quoneq_ftp_client::server_available.wait(lock, [&server] {
+        return quoneq_ftp_client::server_connections[server] <
+            quoneq_ftp_client::server_limit;
+    });
 
-    if(!curl)
-        return lines;
+    quoneq_ftp_client::server_connections[server]++;
+}
 
-    std::string data;
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_WRITEFUNCTION,
-        quoneq_ftp_client::write_callback
-    );
+void quoneq_ftp_client::release_server_slot(const std::string &server) {
+    {
+        std::lock_guard<std::mutex> lock(quoneq_ftp_client::server_lock);
+        if(--quoneq_ftp_client::server_connections[server] == 0)
+            quoneq_ftp_client::server_connections.erase(server);
+    }
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+    quoneq_ftp_client::server_available.notify_all();
+}
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+void quoneq_ftp_client::crawl_worker(crawl_state* state) {
+    quoneq_ftp_client::acquire_server_slot(state->root);
+
+    {
+        // The session connects lazily, so a worker that only gets its slot
+        // after the crawl has finished never opens a connection.
+        quoneq_ftp_session session(
+            state->root,
+            state->username,
+            state->password
+        );
+
+        while(true) {
+            std::string directory;
+            {
+                std::unique_lock<std::mutex> lock(state->lock);
+                state->ready.wait(lock, [state] {
+                    return !state->pending.empty() || state->outstanding == 0;
+                });
+
+                if(state->pending.empty())
+                    break;
+
+                directory = std::move(state->pending.front());
+                state->pending.pop_front();
+            }
+
+            auto response = session.list_entries(
+                quoneq_ftp_client::extract_ftp_path(directory)
+            );
+            std::vector<std::string> subdirectories;
 
-    CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
+            if(response->errorMessage.empty()) {
+                std::lock_guard<std::mutex> lock(state->callback_lock);
 
-    if(res == CURLE_OK)
-        lines = quoneq_ftp_client::split_str(data, '\n');
+                for(const auto &entry : response->entries) {
+                    std::string fullPath = directory +
+                        quoneq_ftp_client::escape_path(entry.name);
+                    (*state->callback)(fullPath, entry);
 
-    return lines;
-}
+                    if(entry.type == quoneq_ftp_entry_type::directory)
+                        subdirectories.push_back(fullPath + "/");
+                }
+            }
 
-std::pair<bool, std::string> quoneq_ftp_client::parse_ftp_list_line(
-    const std::string &line
-) {
-    if(line.empty())
-        return {false, ""};
+            {
+                std::lock_guard<std::mutex> lock(state->lock);
+                if(!response->errorMessage.empty() && state->error.empty())
+                    state->error = response->errorMessage;
 
-    bool isDir = (line[0] == 'd');
-    std::istringstream iss(line);
-    std::vector<std::string> tokens;
-    std::string token;
+                for(auto &subdirectory : subdirectories)
+                    state->pending.push_back(std::move(subdirectory));
 
-    while(iss >> token)
-        tokens.push_back(token);
+                state->outstanding += subdirectories.size();
+                state->outstanding--;
+            }
 
-    std::string name;
-    if(tokens.size() >= 9) {
-        name = tokens[8];
-        for(size_t i = 9; i < tokens.size(); i++)
-            name += " " + tokens[i];
+            state->ready.notify_all();
+        }
     }
-    else if(!tokens.empty())
-        name = tokens.back();
 
-    return {isDir, name};
+    quoneq_ftp_client::release_server_slot(state->root);
 }
 
-void quoneq_ftp_client::list_recursive_helper(
-    const std::string &ftp_url,
-    const std::string &username,
-    const std::string &password,
-    std::vector<std::string> &accum
-) {
-    auto lines = quoneq_ftp_client::get_list_detail(
-        ftp_url,
-        username,
-        password
+/**
+ * @brief Returns the modification time of a local file as a time_t.
+ */
+static std::time_t local_modified(const std::filesystem::path &path) {
+    std::error_code error;
+    auto stamp = std::filesystem::last_write_time(path, error);
+
+    if(error)
+        return -1;
+
+    return std::chrono::system_clock::to_time_t(
+        std::chrono::file_clock::to_sys(stamp)
     );
-    for(const auto &line : lines) {
-        auto parsed = quoneq_ftp_client::parse_ftp_list_line(line);
-        bool isDir = parsed.first;
+}
 
-        std::string name = parsed.second;
-        if(name == "." || name == ".." || name.empty())
-            continue;
+/**
+ * @brief Joins a relative path to a directory, refusing paths that leave it.
+ *
+ * @param root The directory.
+ * @param relative The path below it, as derived from a remote listing.
+ * @param target Receives the normalised joined path.
+ * @return true if the target lies strictly inside the directory.
+ */
+static bool contained_path(
+    const std::filesystem::path &root,
+    const std::string &relative,
+    std::filesystem::path &target
+) {
+    std::filesystem::path base = root.lexically_normal();
+    target = (base / relative).lexically_normal();
 
-        std::string fullPath = ftp_url;
-        if(fullPath.back() != '/')
-            fullPath += "/";
+    std::filesystem::path inside = target.lexically_relative(base);
+    return !inside.empty() && !inside.is_absolute() &&
+        *inside.begin() != ".." && *inside.begin() != ".";
+}
 
-        fullPath += name;
-        accum.push_back(fullPath);
+std::map<std::string, quoneq_ftp_client::mirror_record> quoneq_ftp_client::load_manifest(
+    const std::string &path
+) {
+    std::map<std::string, mirror_record> manifest;
+    std::ifstream file(path);
+    std::string line;
+
+    // One file per line: remote size, remote time, local size, local time
+    // and the relative path, separated by tabs. The path comes last so it
+    // may itself contain tabs.
+    while(std::getline(file, line)) {
+        if(line.empty() || line[0] == '#')
+            continue;
 
-        if(isDir)
-            quoneq_ftp_client::list_recursive_helper(
-                fullPath,
-                username,
-                password,
-                accum
+        std::int64_t fields[4] = {0, 0, 0, 0};
+        size_t start = 0;
+        bool valid = true;
+
+        for(auto &field : fields) {
+            size_t end = line.find('\t', start);
+            if(end == std::string::npos) {
+                valid = false;
+                break;
+            }
+
+            auto parsed = std::from_chars(
+                line.data() + start,
+                line.data() + end,
+                field
             );
+
+            valid = valid && parsed.ec == std::errc();
+            start = end + 1;
+        }
+
+        if(!valid || start >= line.size())
+            continue;
+
+        mirror_record record;
+        record.remoteSize = fields[0];
+        record.remoteModified = static_cast<std::time_t>(fields[1]);
+        record.localSize = fields[2];
+        record.localModified = static_cast<std::time_t>(fields[3]);
+
+        manifest[line.substr(start)] = record;
+    }
+
+    return manifest;
+}
+
+bool quoneq_ftp_client::save_manifest(
+    const std::string &path,
+    const std::map<std::string, mirror_record> &manifest
+) {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if(!file.is_open())
+            return false;
+
+        file << "# quoneq ftp mirror manifest\n";
+        for(const auto &[relative, record] : manifest)
+            file << record.remoteSize << '\t'
+                << static_cast<std::int64_t>(record.remoteModified) << '\t'
+                << record.localSize << '\t'
+                << static_cast<std::int64_t>(record.localModified) << '\t'
+                << relative << '\n';
+
+        file.flush();
+        if(!file.good())
+            return false;
     }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+
+    return !error;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::upload(
+bool quoneq_ftp_client::mirror_unchanged(
+    const mirror_file &file,
+    const mirror_record* previous,
+    quoneq_ftp_mirror_direction direction
+) {
+    if(!file.remote || !file.local)
+        return false;
+
+    const mirror_record &now = file.state;
+    if(previous)
+        return previous->remoteSize == now.remoteSize &&
+            previous->remoteModified == now.remoteModified &&
+            previous->localSize == now.localSize &&
+            previous->localModified == now.localModified;
+
+    if(now.remoteSize >= 0 && now.remoteSize != now.localSize)
+        return false;
+
+    if(now.remoteModified == -1)
+        return false;
+
+    if(direction == quoneq_ftp_mirror_direction::download)
+        return now.localModified == now.remoteModified;
+
+    return now.remoteModified >= now.localModified;
+}
+
+std::string quoneq_ftp_client::server_root(const std::string &ftp_url) {
+    std::string path = quoneq_ftp_client::extract_ftp_path(ftp_url);
+    return ftp_url.substr(0, ftp_url.size() - path.size()) + "/";
+}
+
+void quoneq_ftp_client::prepare_handle(
+    CURL* curl,
     const std::string &ftp_url,
-    const std::string &local_file,
     const std::string &username,
     const std::string &password
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
-    CURL* curl = curl_easy_init();
-
-    if(!curl) {
-        response->errorMessage = "Failed to initialize curl";
-        return response;
-    }
-
-    std::ifstream file(local_file, std::ios::binary);
-    if(!file.is_open()) {
-        response->errorMessage = "Unable to open local file for reading";
-        curl_easy_cleanup(curl);
+    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
+    quoneq_net::attach_share(curl);
+    quoneq_net::apply_ca_cert(curl);
 
-        return response;
-    }
+    if(!username.empty())
+        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
 
-    file.seekg(0, std::ios::end);
+    if(!password.empty())
+        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+}
 
-    std::streampos fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::perform_upload(
+    CURL* curl,
+    const std::string &ftp_url,
+    quoneq_upload_source* source,
+    const std::string &username,
+    const std::string &password
+) {
+    auto response = std::make_unique<quoneq_ftp_response>();
 
+    quoneq_ftp_client::prepare_handle(curl, ftp_url, username, password);
     curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_READDATA, &file);
+    curl_easy_setopt(curl, CURLOPT_READDATA, source);
     curl_easy_setopt(
         curl,
         CURLOPT_READFUNCTION,
         quoneq_ftp_client::read_file_callback
     );
+    curl_easy_setopt(curl, CURLOPT_SEEKDATA, source);
     curl_easy_setopt(
         curl,
-        CURLOPT_INFILESIZE_LARGE,
-        static_cast<curl_off_t>(fileSize)
+        CURLOPT_SEEKFUNCTION,
+        quoneq_ftp_client::seek_file_callback
     );
     curl_easy_setopt(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        CURLOPT_INFILESIZE_LARGE,
+        static_cast<curl_off_t>(source->size())
     );
-
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
-
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+#if LIBCURL_VERSION_NUM >= 0x073E00
+    // The data is already in memory; hand it over in larger pieces.
+    curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, 512L * 1024L);
+#endif
 
     CURLcode res = curl_easy_perform(curl);
     if(res != CURLE_OK)
@@ -257,448 +474,1100 @@ std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::upload(
         &response->responseCode
     );
 
-    curl_easy_cleanup(curl);
-    file.close();
-
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::download_file(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::upload(
     const std::string &ftp_url,
     const std::string &local_file,
     const std::string &username,
     const std::string &password
 ) {
     auto response = std::make_unique<quoneq_ftp_response>();
-    CURL* curl = curl_easy_init();
+    quoneq_upload_source source(local_file);
 
-    if(!curl) {
-        response->errorMessage = "Failed to initialize curl";
+    if(!source.is_open()) {
+        response->errorMessage = "Unable to open local file for reading";
         return response;
     }
 
-    std::ofstream outfile(local_file, std::ios::binary);
-    if(!outfile.is_open()) {
-        response->errorMessage = "Unable to open local file for writing";
-        curl_easy_cleanup(curl);
-
+    CURL* curl = curl_easy_init();
+    if(!curl) {
+        response->errorMessage = "Failed to initialize curl";
         return response;
     }
 
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &outfile);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_WRITEFUNCTION,
-        quoneq_ftp_client::write_file_callback
-    );
-    curl_easy_setopt(
-        curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
-    );
-
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
-
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
-
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
-    else curl_easy_getinfo(
+    response = quoneq_ftp_client::perform_upload(
         curl,
-        CURLINFO_RESPONSE_CODE,
-        &response->responseCode
+        ftp_url,
+        &source,
+        username,
+        password
     );
 
-    curl_easy_cleanup(curl);
-    outfile.close();
-
+    quoneq_net::cleanup_handle(curl);
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::read(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::upload(
     const std::string &ftp_url,
+    std::span<const std::byte> data,
     const std::string &username,
     const std::string &password
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
     CURL* curl = curl_easy_init();
-
     if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
         response->errorMessage = "Failed to initialize curl";
+
         return response;
     }
 
-    std::string data;
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_WRITEFUNCTION,
-        quoneq_ftp_client::write_callback
-    );
-    curl_easy_setopt(
+    quoneq_upload_source source(data);
+    auto response = quoneq_ftp_client::perform_upload(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        ftp_url,
+        &source,
+        username,
+        password
     );
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
-
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
-
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
-    else {
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response->responseCode);
-        response->content = data;
-    }
-
-    curl_easy_cleanup(curl);
+    quoneq_net::cleanup_handle(curl);
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::remove(
+void quoneq_ftp_client::prepare_download(
+    file_download* download,
     const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
-    CURL* curl = curl_easy_init();
-
-    if(!curl) {
-        response->errorMessage = "Failed to initialize curl";
-        return response;
-    }
+    CURL* curl = download->curl;
 
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    quoneq_ftp_client::prepare_handle(curl, ftp_url, username, password);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, download);
     curl_easy_setopt(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        CURLOPT_WRITEFUNCTION,
+        quoneq_ftp_client::write_file_callback
     );
+}
 
-    std::string path = quoneq_ftp_client::extract_ftp_path(ftp_url);
-    std::string deleCmd = "DELE " + path;
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::perform_download(
+    CURL* curl,
+    const std::string &ftp_url,
+    const std::string &local_file,
+    const std::string &username,
+    const std::string &password,
+    const quoneq_file_sink_options &sink_options
+) {
+    auto response = std::make_unique<quoneq_ftp_response>();
 
-    struct curl_slist* cmdList = nullptr;
-    cmdList = curl_slist_append(cmdList, deleCmd.c_str());
-    curl_easy_setopt(curl, CURLOPT_QUOTE, cmdList);
+    quoneq_file_sink outfile(local_file, sink_options);
+    if(!outfile.is_open()) {
+        response->errorMessage = "Unable to open local file for writing";
+        return response;
+    }
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+    file_download download;
+    download.curl = curl;
+    download.file = &outfile;
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+    quoneq_ftp_client::prepare_download(
+        &download,
+        ftp_url,
+        username,
+        password
+    );
 
     CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
+    bool stored = outfile.close();
+
+    if(res == CURLE_WRITE_ERROR && !stored)
+        response->errorMessage = outfile.error();
+    else if(res != CURLE_OK)
         response->errorMessage = curl_easy_strerror(res);
+    else if(!stored)
+        response->errorMessage = outfile.error();
     else curl_easy_getinfo(
         curl,
         CURLINFO_RESPONSE_CODE,
         &response->responseCode
     );
 
-    curl_slist_free_all(cmdList);
-    curl_easy_cleanup(curl);
-
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::list(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::download_file(
     const std::string &ftp_url,
+    const std::string &local_file,
     const std::string &username,
-    const std::string &password
+    const std::string &password,
+    const quoneq_file_sink_options &sink_options
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
     CURL* curl = curl_easy_init();
-
     if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
         response->errorMessage = "Failed to initialize curl";
+
         return response;
     }
 
-    std::string data;
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-    curl_easy_setopt(curl, CURLOPT_DIRLISTONLY, 1L);
-    curl_easy_setopt(
+    auto response = quoneq_ftp_client::perform_download(
         curl,
-        CURLOPT_WRITEFUNCTION,
-        quoneq_ftp_client::write_callback
+        ftp_url,
+        local_file,
+        username,
+        password,
+        sink_options
     );
+
+    quoneq_net::cleanup_handle(curl);
+    return response;
+}
+
+std::future<std::unique_ptr<quoneq_ftp_response>> quoneq_ftp_client::download_file_async(
+    const std::string &ftp_url,
+    const std::string &local_file,
+    const std::string &username,
+    const std::string &password,
+    const quoneq_file_sink_options &sink_options
+) {
+    auto task = std::make_shared<async_download>();
+    auto future = task->promise.get_future();
+
+    task->response = std::make_unique<quoneq_ftp_response>();
+    task->destination.curl = curl_easy_init();
+
+    if(!task->destination.curl) {
+        task->response->errorMessage = "Failed to initialize curl";
+        task->promise.set_value(std::move(task->response));
+
+        return future;
+    }
+
+    task->outfile = std::make_unique<quoneq_file_sink>(local_file, sink_options);
+    if(!task->outfile->is_open()) {
+        task->response->errorMessage = "Unable to open local file for writing";
+        quoneq_net::cleanup_handle(task->destination.curl);
+        task->promise.set_value(std::move(task->response));
+
+        return future;
+    }
+
+    task->destination.file = task->outfile.get();
+    quoneq_ftp_client::prepare_download(
+        &task->destination,
+        ftp_url,
+        username,
+        password
+    );
+
+    quoneq_event_loop::submit(task->destination.curl, [task](CURLcode result) {
+        bool stored = task->outfile->close();
+
+        if(result == CURLE_WRITE_ERROR && !stored)
+            task->response->errorMessage = task->outfile->error();
+        else if(result != CURLE_OK)
+            task->response->errorMessage = curl_easy_strerror(result);
+        else if(!stored)
+            task->response->errorMessage = task->outfile->error();
+        else curl_easy_getinfo(
+            task->destination.curl,
+            CURLINFO_RESPONSE_CODE,
+            &task->response->responseCode
+        );
+
+        quoneq_net::cleanup_handle(task->destination.curl);
+        task->promise.set_value(std::move(task->response));
+    });
+
+    return future;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::perform_read(
+    CURL* curl,
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password,
+    bool names_only
+) {
+    auto response = std::make_unique<quoneq_ftp_response>();
+    std::string data;
+
+    quoneq_ftp_client::prepare_handle(curl, ftp_url, username, password);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
     curl_easy_setopt(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        CURLOPT_WRITEFUNCTION,
+        quoneq_ftp_client::write_callback
     );
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
-
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+    if(names_only)
+        curl_easy_setopt(curl, CURLOPT_DIRLISTONLY, 1L);
 
     CURLcode res = curl_easy_perform(curl);
     if(res != CURLE_OK)
         response->errorMessage = curl_easy_strerror(res);
     else {
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response->responseCode);
-        response->content = data;
-        response->list = quoneq_ftp_client::split_str(data, '\n');
+        response->content = std::move(data);
     }
 
-    curl_easy_cleanup(curl);
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::list_recursive(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::perform_commands(
+    CURL* curl,
     const std::string &ftp_url,
+    const std::vector<std::string> &commands,
     const std::string &username,
     const std::string &password
 ) {
     auto response = std::make_unique<quoneq_ftp_response>();
-    std::vector<std::string> accum;
 
-    list_recursive_helper(ftp_url, username, password, accum);
-    response->list = accum;
+    // The commands carry their own absolute paths, so the transfer itself
+    // targets the server root and only logs in and runs them.
+    std::string root = quoneq_ftp_client::server_root(ftp_url);
+    quoneq_ftp_client::prepare_handle(curl, root, username, password);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+
+    struct curl_slist* cmdList = nullptr;
+    for(const auto &command : commands)
+        cmdList = curl_slist_append(cmdList, command.c_str());
+    curl_easy_setopt(curl, CURLOPT_QUOTE, cmdList);
+
+    CURLcode res = curl_easy_perform(curl);
+    if(res != CURLE_OK)
+        response->errorMessage = curl_easy_strerror(res);
+    else curl_easy_getinfo(
+        curl,
+        CURLINFO_RESPONSE_CODE,
+        &response->responseCode
+    );
 
+    curl_slist_free_all(cmdList);
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::move(
-    const std::string &ftp_url_from,
-    const std::string &ftp_url_to,
+quoneq_ftp_stat quoneq_ftp_client::perform_stat(
+    CURL* curl,
+    const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
-    CURL* curl = curl_easy_init();
+    quoneq_ftp_stat result;
+    std::string target = ftp_url;
 
-    if(!curl) {
-        response->errorMessage = "Failed to initialize curl";
-        return response;
-    }
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url_from.c_str());
+    while(!target.empty() && target.back() == '/')
+        target.pop_back();
 
-    std::string path_from = quoneq_ftp_client::extract_ftp_path(ftp_url_from);
-    std::string path_to = quoneq_ftp_client::extract_ftp_path(ftp_url_to);
-    std::string rnfrCmd = "RNFR " + path_from;
-    std::string rntoCmd = "RNTO " + path_to;
+    std::string path = quoneq_ftp_client::extract_ftp_path(target);
+    std::string escaped_name = path.substr(path.find_last_of('/') + 1);
+    std::string name = quoneq_ftp_client::unescape_path(escaped_name);
 
-    struct curl_slist* cmdList = nullptr;
-    cmdList = curl_slist_append(cmdList, rnfrCmd.c_str());
-    cmdList = curl_slist_append(cmdList, rntoCmd.c_str());
-    curl_easy_setopt(curl, CURLOPT_QUOTE, cmdList);
+    server_features supported = quoneq_ftp_client::probe_features(
+        curl,
+        ftp_url,
+        username,
+        password
+    );
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+    if(supported.mlst) {
+        std::string replies;
+        std::string command = "*MLST " +
+            (path.empty() ? "/" : quoneq_ftp_client::unescape_path(path));
+        struct curl_slist* cmdList = curl_slist_append(nullptr, command.c_str());
+
+        quoneq_ftp_client::prepare_handle(
+            curl,
+            quoneq_ftp_client::server_root(ftp_url),
+            username,
+            password
+        );
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(curl, CURLOPT_QUOTE, cmdList);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &replies);
+        curl_easy_setopt(
+            curl,
+            CURLOPT_HEADERFUNCTION,
+            quoneq_ftp_client::write_callback
+        );
+
+        CURLcode res = curl_easy_perform(curl);
+
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 0L);
+        curl_easy_setopt(curl, CURLOPT_QUOTE, nullptr);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, nullptr);
+        curl_slist_free_all(cmdList);
+
+        if(res != CURLE_OK) {
+            result.errorMessage = curl_easy_strerror(res);
+            return result;
+        }
+
+        // The facts arrive as the indented line of a multi-line 250 reply;
+        // a missing path gets a 550 instead, which the '*' let through.
+        bool facts = false;
+        for(auto &line : quoneq_ftp_client::split_str(replies, '\n')) {
+            if(!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if(line.rfind("250-", 0) == 0)
+                facts = true;
+            else if(facts && line.size() > 1 && line[0] == ' ') {
+                result.exists = quoneq_ftp_listing::parse_facts(
+                    std::string_view(line).substr(1),
+                    result.entry,
+                    false
+                );
+                break;
+            }
+        }
+
+        result.entry.name = name;
+        return result;
+    }
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+    if(!path.empty() && !supported.size) {
+        // Without SIZE a missing file is indistinguishable from an empty
+        // one, so fall back to finding the path in its parent's listing.
+        auto listing = quoneq_ftp_client::perform_list_entries(
+            curl,
+            target.substr(0, target.size() - escaped_name.size()),
+            username,
+            password
+        );
+
+        // A parent that cannot be entered does not exist, and neither does
+        // the path; only the error text of the listing is available here.
+        if(listing->errorMessage == curl_easy_strerror(CURLE_REMOTE_ACCESS_DENIED)) {
+            result.entry.name = name;
+            return result;
+        }
+
+        if(!listing->errorMessage.empty()) {
+            result.errorMessage = listing->errorMessage;
+            return result;
+        }
+
+        for(auto &entry : listing->entries)
+            if(entry.name == name) {
+                result.exists = true;
+                result.entry = std::move(entry);
+                break;
+            }
+
+        result.entry.name = name;
+        return result;
+    }
 
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
-    else curl_easy_getinfo(
+    std::string headers;
+    quoneq_ftp_client::prepare_handle(curl, target, username, password);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &headers);
+    curl_easy_setopt(
         curl,
-        CURLINFO_RESPONSE_CODE,
-        &response->responseCode
+        CURLOPT_WRITEFUNCTION,
+        quoneq_ftp_client::write_callback
     );
 
-    curl_slist_free_all(cmdList);
-    curl_easy_cleanup(curl);
+    CURLcode res = CURLE_REMOTE_FILE_NOT_FOUND;
+    if(!path.empty()) {
+        // NOBODY makes libcurl send SIZE (and MDTM with FILETIME) and stop
+        // there, without opening a data connection.
+        curl_easy_setopt(curl, CURLOPT_FILETIME, supported.mdtm ? 1L : 0L);
+        res = curl_easy_perform(curl);
+    }
 
-    return response;
+    if(res == CURLE_OK) {
+        curl_off_t size = -1;
+        curl_off_t modified = -1;
+
+        curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &size);
+        curl_easy_getinfo(curl, CURLINFO_FILETIME_T, &modified);
+
+        result.exists = true;
+        result.entry.type = quoneq_ftp_entry_type::file;
+        result.entry.size = static_cast<std::int64_t>(size);
+        result.entry.modified = static_cast<std::time_t>(modified);
+    }
+    else if(res == CURLE_REMOTE_FILE_NOT_FOUND ||
+        res == CURLE_FTP_COULDNT_RETR_FILE) {
+        // Not a file; a CWD into it tells whether it is a directory.
+        curl_easy_setopt(curl, CURLOPT_FILETIME, 0L);
+        curl_easy_setopt(curl, CURLOPT_URL, (target + "/").c_str());
+
+        res = curl_easy_perform(curl);
+        if(res == CURLE_OK) {
+            result.exists = true;
+            result.entry.type = quoneq_ftp_entry_type::directory;
+        }
+        else if(res != CURLE_REMOTE_ACCESS_DENIED &&
+            res != CURLE_REMOTE_FILE_NOT_FOUND)
+            result.errorMessage = curl_easy_strerror(res);
+    }
+    // libcurl reports a failed CWD into the parent directory as access
+    // denied (CURLE_FTP_ACCESS_DENIED is its old name): the parent, and so
+    // the path, does not exist.
+    else if(res != CURLE_REMOTE_ACCESS_DENIED)
+        result.errorMessage = curl_easy_strerror(res);
+
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 0L);
+    curl_easy_setopt(curl, CURLOPT_FILETIME, 0L);
+
+    result.entry.name = name;
+    return result;
 }
 
-bool quoneq_ftp_client::exists(
+quoneq_ftp_client::server_features quoneq_ftp_client::probe_features(
+    CURL* curl,
     const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    CURL* curl = curl_easy_init();
+    std::string root = quoneq_ftp_client::server_root(ftp_url);
+    {
+        std::lock_guard<std::mutex> lock(quoneq_ftp_client::feature_lock);
+        auto found = quoneq_ftp_client::features.find(root);
 
-    if(!curl)
-        return false;
+        if(found != quoneq_ftp_client::features.end())
+            return found->second;
+    }
 
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
+    server_features supported;
+    std::string replies;
+
+    // A leading '*' lets the transfer succeed on servers without FEAT,
+    // which then simply advertise nothing.
+    struct curl_slist* cmdList = curl_slist_append(nullptr, "*FEAT");
+
+    quoneq_ftp_client::prepare_handle(curl, root, username, password);
     curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_QUOTE, cmdList);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &replies);
     curl_easy_setopt(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        CURLOPT_HEADERFUNCTION,
+        quoneq_ftp_client::write_callback
     );
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+    CURLcode res = curl_easy_perform(curl);
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 0L);
+    curl_easy_setopt(curl, CURLOPT_QUOTE, nullptr);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, nullptr);
+    curl_slist_free_all(cmdList);
 
-    CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
+    if(res != CURLE_OK)
+        return supported;
+
+    // Features are listed one per line, each indented by a single space.
+    for(const auto &line : quoneq_ftp_client::split_str(replies, '\n')) {
+        if(line.size() < 5 || line[0] != ' ')
+            continue;
+
+        std::string feature = line.substr(1, 4);
+        for(auto &c : feature)
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
 
-    return (res == CURLE_OK);
+        if(feature == "MLST")
+            supported.mlst = true;
+        else if(feature == "SIZE")
+            supported.size = true;
+        else if(feature == "MDTM")
+            supported.mdtm = true;
+    }
+
+    std::lock_guard<std::mutex> lock(quoneq_ftp_client::feature_lock);
+    quoneq_ftp_client::features[root] = supported;
+
+    return supported;
 }
 
-bool quoneq_ftp_client::is_file(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::perform_list_entries(
+    CURL* curl,
     const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    auto info = file_info(ftp_url, username, password);
-    if(!info->content.empty() && info->content[0] == '-')
-        return true;
+    std::string directory = ftp_url;
+    if(directory.empty() || directory.back() != '/')
+        directory += "/";
+
+    server_features supported = quoneq_ftp_client::probe_features(
+        curl,
+        directory,
+        username,
+        password
+    );
+
+    if(supported.mlst)
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "MLSD");
 
-    return false;
+    auto response = quoneq_ftp_client::perform_read(
+        curl,
+        directory,
+        username,
+        password,
+        false
+    );
+    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, nullptr);
+
+    if(response->errorMessage.empty())
+        response->entries = quoneq_ftp_listing::parse(
+            response->content,
+            supported.mlst
+        );
+
+    return response;
 }
 
-bool quoneq_ftp_client::is_folder(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::read(
     const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    auto info = folder_info(ftp_url, username, password);
-    return !info->content.empty() && info->content[0] == 'd';
+    CURL* curl = curl_easy_init();
+    if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    auto response = quoneq_ftp_client::perform_read(
+        curl,
+        ftp_url,
+        username,
+        password,
+        false
+    );
+
+    quoneq_net::cleanup_handle(curl);
+    return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::create(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::remove(
     const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
     CURL* curl = curl_easy_init();
-
     if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
         response->errorMessage = "Failed to initialize curl";
+
         return response;
     }
 
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    std::string path = quoneq_ftp_client::extract_ftp_path(ftp_url);
-    std::string mkdCmd = "MKD " + path;
+    std::string path = quoneq_ftp_client::command_path(ftp_url);
+    auto response = quoneq_ftp_client::perform_commands(
+        curl,
+        ftp_url,
+        { "DELE " + path },
+        username,
+        password
+    );
 
-    struct curl_slist* cmdList = nullptr;
-    cmdList = curl_slist_append(cmdList, mkdCmd.c_str());
-    curl_easy_setopt(curl, CURLOPT_QUOTE, cmdList);
+    quoneq_net::cleanup_handle(curl);
+    return response;
+}
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::list(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+        return response;
+    }
 
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
-    else curl_easy_getinfo(
+    auto response = quoneq_ftp_client::perform_read(
         curl,
-        CURLINFO_RESPONSE_CODE,
-        &response->responseCode
+        ftp_url,
+        username,
+        password,
+        true
     );
 
-    curl_slist_free_all(cmdList);
-    curl_easy_cleanup(curl);
+    if(response->errorMessage.empty())
+        response->list = quoneq_ftp_client::split_str(response->content, '\n');
 
+    quoneq_net::cleanup_handle(curl);
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::file_info(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::list_entries(
     const std::string &ftp_url,
     const std::string &username,
     const std::string &password
 ) {
-    auto response = std::make_unique<quoneq_ftp_response>();
     CURL* curl = curl_easy_init();
-
     if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
         response->errorMessage = "Failed to initialize curl";
+
         return response;
     }
 
-    std::string data;
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_WRITEFUNCTION,
-        quoneq_ftp_client::write_callback
-    );
-    curl_easy_setopt(
+    auto response = quoneq_ftp_client::perform_list_entries(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        ftp_url,
+        username,
+        password
     );
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+    quoneq_net::cleanup_handle(curl);
+    return response;
+}
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::list_recursive(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    std::vector<std::string> accum;
+    auto response = quoneq_ftp_client::list_recursive(
+        ftp_url,
+        [&accum](const std::string &entry_url, const quoneq_ftp_entry &entry) {
+            (void) entry;
+            accum.push_back(entry_url);
+        },
+        4,
+        username,
+        password
+    );
 
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
-    else {
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response->responseCode);
-        response->content = data;
-    }
+    std::sort(accum.begin(), accum.end());
+    response->list = std::move(accum);
 
-    curl_easy_cleanup(curl);
     return response;
 }
 
-std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::folder_info(
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::list_recursive(
     const std::string &ftp_url,
+    const quoneq_ftp_list_callback &callback,
+    size_t workers,
     const std::string &username,
     const std::string &password
 ) {
     auto response = std::make_unique<quoneq_ftp_response>();
-    CURL* curl = curl_easy_init();
+    crawl_state state;
+
+    std::string directory = ftp_url;
+    if(directory.empty() || directory.back() != '/')
+        directory += "/";
+
+    state.root = quoneq_ftp_client::server_root(ftp_url);
+    state.username = username;
+    state.password = password;
+    state.callback = &callback;
+    state.pending.push_back(directory);
+    state.outstanding = 1;
+
+    std::vector<std::thread> pool;
+    for(size_t i = 0; i < std::max<size_t>(workers, 1); i++)
+        pool.emplace_back(quoneq_ftp_client::crawl_worker, &state);
+
+    for(auto &worker : pool)
+        worker.join();
+
+    response->errorMessage = state.error;
+    return response;
+}
+
+void quoneq_ftp_client::set_server_connection_limit(size_t limit) {
+    {
+        std::lock_guard<std::mutex> lock(quoneq_ftp_client::server_lock);
+        quoneq_ftp_client::server_limit = std::max<size_t>(limit, 1);
+    }
+
+    quoneq_ftp_client::server_available.notify_all();
+}
+
+quoneq_ftp_mirror_result quoneq_ftp_client::mirror(
+    const std::string &ftp_url,
+    const std::string &local_dir,
+    const quoneq_ftp_mirror_options &options,
+    const std::string &username,
+    const std::string &password
+) {
+    quoneq_ftp_mirror_result result;
+    bool download = options.direction == quoneq_ftp_mirror_direction::download;
+
+    std::string remote = ftp_url;
+    if(remote.empty() || remote.back() != '/')
+        remote += "/";
+
+    std::string root = quoneq_ftp_client::server_root(remote);
+    std::string remote_path = quoneq_ftp_client::extract_ftp_path(remote);
+    std::filesystem::path local_root(local_dir);
+    std::error_code error;
+
+    if(download)
+        std::filesystem::create_directories(local_root, error);
+    else {
+        quoneq_ftp_session session(root, username, password);
+        auto info = session.stat(remote_path);
+
+        if(!info.errorMessage.empty()) {
+            result.errorMessage = info.errorMessage;
+            return result;
+        }
+
+        if(!info.exists) {
+            auto created = session.create(remote_path);
+            if(!created->errorMessage.empty()) {
+                result.errorMessage = created->errorMessage;
+                return result;
+            }
+        }
+    }
+
+    std::map<std::string, mirror_file> files;
+    std::vector<std::string> remote_dirs, local_dirs;
+
+    auto listing = quoneq_ftp_client::list_recursive(
+        remote,
+        [&](const std::string &entry_url, const quoneq_ftp_entry &entry) {
+            std::string relative = quoneq_ftp_client::unescape_path(
+                entry_url.substr(remote.size())
+            );
+
+            if(entry.type == quoneq_ftp_entry_type::directory)
+                remote_dirs.push_back(relative);
+            else if(entry.type == quoneq_ftp_entry_type::file) {
+                mirror_file &file = files[relative];
+
+                file.remote = true;
+                file.state.remoteSize = entry.size;
+                file.state.remoteModified = entry.modified;
+            }
+        },
+        options.workers,
+        username,
+        password
+    );
+
+    if(!listing->errorMessage.empty()) {
+        if(download && files.empty() && remote_dirs.empty()) {
+            result.errorMessage = listing->errorMessage;
+            return result;
+        }
+
+        result.errors.push_back("listing: " + listing->errorMessage);
+    }
+
+    for(auto it = std::filesystem::recursive_directory_iterator(local_root, error);
+        !error && it != std::filesystem::recursive_directory_iterator();
+        it.increment(error)) {
+        std::string relative = it->path().lexically_relative(local_root).generic_string();
+
+        if(it->is_directory(error))
+            local_dirs.push_back(relative);
+        else if(it->is_regular_file(error)) {
+            mirror_file &file = files[relative];
+
+            file.local = true;
+            file.state.localSize = static_cast<std::int64_t>(it->file_size(error));
+            file.state.localModified = local_modified(it->path());
+        }
+    }
+
+    if(error && !download) {
+        result.errorMessage = error.message();
+        return result;
+    }
+
+    // Parents sort before their children, so they are created first.
+    if(download)
+        for(const auto &relative : remote_dirs) {
+            std::filesystem::path directory;
+
+            if(contained_path(local_root, relative, directory))
+                std::filesystem::create_directories(directory, error);
+            else result.errors.push_back(relative + ": outside of the local directory");
+        }
+    else {
+        std::sort(local_dirs.begin(), local_dirs.end());
+        std::sort(remote_dirs.begin(), remote_dirs.end());
+
+        quoneq_ftp_session session(root, username, password);
+        for(const auto &relative : local_dirs) {
+            if(std::binary_search(remote_dirs.begin(), remote_dirs.end(), relative))
+                continue;
+
+            auto created = session.create(
+                remote_path + quoneq_ftp_client::escape_path(relative)
+            );
+            if(!created->errorMessage.empty())
+                result.errors.push_back(relative + ": " + created->errorMessage);
+        }
+    }
+
+    auto previous = options.manifest.empty()
+        ? std::map<std::string, mirror_record>()
+        : quoneq_ftp_client::load_manifest(options.manifest);
+    std::map<std::string, mirror_record> manifest;
+    std::vector<mirror_file*> pending;
+
+    for(auto &[relative, file] : files) {
+        file.relative = relative;
+        if(download ? !file.remote : !file.local)
+            continue;
+
+        auto found = previous.find(relative);
+        const mirror_record* record = found == previous.end() ? nullptr : &found->second;
+
+        if(quoneq_ftp_client::mirror_unchanged(file, record, options.direction)) {
+            result.unchanged++;
+            manifest[relative] = file.state;
+        }
+        else pending.push_back(&file);
+    }
+
+    size_t next = 0;
+    std::mutex lock;
+    bool machine = false;
+    {
+        std::lock_guard<std::mutex> guard(quoneq_ftp_client::feature_lock);
+        auto found = quoneq_ftp_client::features.find(root);
+
+        machine = found != quoneq_ftp_client::features.end() && found->second.mlst;
+    }
+
+    auto transfer = [&]() {
+        quoneq_ftp_client::acquire_server_slot(root);
+
+        {
+            quoneq_ftp_session session(root, username, password);
+            while(true) {
+                mirror_file* file = nullptr;
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if(next == pending.size())
+                        break;
+
+                    file = pending[next++];
+                }
+
+                std::string path = remote_path +
+                    quoneq_ftp_client::escape_path(file->relative);
+                std::filesystem::path local_file;
+                mirror_record state = file->state;
+                std::string failure;
+
+                if(!contained_path(local_root, file->relative, local_file))
+                    failure = "outside of the local directory";
+                else if(download) {
+                    auto response = session.download_file(path, local_file.string());
+                    failure = response->errorMessage;
+
+                    if(failure.empty()) {
+                        std::error_code stamp_error;
+
+                        // Stamp the copy with the remote time so that the next
+                        // run recognises it even without a manifest.
+                        if(state.remoteModified != -1)
+                            std::filesystem::last_write_time(
+                                local_file,
+                                std::chrono::file_clock::from_sys(
+                                    std::chrono::system_clock::from_time_t(state.remoteModified)
+                                ),
+                                stamp_error
+                            );
+
+                        state.localSize = static_cast<std::int64_t>(
+                            std::filesystem::file_size(local_file, stamp_error)
+                        );
+                        state.localModified = local_modified(local_file);
+                    }
+                }
+                else {
+                    auto response = session.upload(path, local_file.string());
+                    failure = response->errorMessage;
+
+                    if(failure.empty()) {
+                        // Record the remote state as the next listing will
+                        // report it: MLST matches MLSD, but LIST times are
+                        // coarser than MDTM, so those come from the parent.
+                        quoneq_ftp_entry uploaded;
+                        if(machine)
+                            uploaded = session.stat(path).entry;
+                        else {
+                            std::string parent = path.substr(0, path.find_last_of('/') + 1);
+                            std::string name = path.substr(parent.size());
+                            auto listed = session.list_entries(parent);
+
+                            for(auto &entry : listed->entries)
+                                if(entry.name == name) {
+                                    uploaded = std::move(entry);
+                                    break;
+                                }
+                        }
+
+                        state.remoteSize = uploaded.size;
+                        state.remoteModified = uploaded.modified;
+                    }
+                }
+
+                std::lock_guard<std::mutex> guard(lock);
+                if(failure.empty()) {
+                    result.transferred++;
+                    result.bytes += static_cast<std::uint64_t>(
+                        std::max<std::int64_t>(state.localSize, 0)
+                    );
+                    manifest[file->relative] = state;
+                }
+                else {
+                    result.failed++;
+                    result.errors.push_back(file->relative + ": " + failure);
+                }
+            }
+        }
+
+        quoneq_ftp_client::release_server_slot(root);
+    };
+
+    std::vector<std::thread> pool;
+    size_t workers = std::min(std::max<size_t>(options.workers, 1), pending.size());
+
+    for(size_t i = 0; i < workers; i++)
+        pool.emplace_back(transfer);
+
+    for(auto &worker : pool)
+        worker.join();
+
+    if(!options.manifest.empty() &&
+        !quoneq_ftp_client::save_manifest(options.manifest, manifest))
+        result.errors.push_back(options.manifest + ": unable to write manifest");
+
+    return result;
+}
 
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::move(
+    const std::string &ftp_url_from,
+    const std::string &ftp_url_to,
+    const std::string &username,
+    const std::string &password
+) {
+    CURL* curl = curl_easy_init();
     if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
         response->errorMessage = "Failed to initialize curl";
+
         return response;
     }
 
-    std::string data;
-    curl_easy_setopt(curl, CURLOPT_URL, ftp_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
-    curl_easy_setopt(
+    std::string path_from = quoneq_ftp_client::command_path(ftp_url_from);
+    std::string path_to = quoneq_ftp_client::command_path(ftp_url_to);
+    auto response = quoneq_ftp_client::perform_commands(
         curl,
-        CURLOPT_WRITEFUNCTION,
-        quoneq_ftp_client::write_callback
+        ftp_url_from,
+        { "RNFR " + path_from, "RNTO " + path_to },
+        username,
+        password
     );
-    curl_easy_setopt(
+
+    quoneq_net::cleanup_handle(curl);
+    return response;
+}
+
+quoneq_ftp_stat quoneq_ftp_client::stat(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl) {
+        quoneq_ftp_stat result;
+        result.errorMessage = "Failed to initialize curl";
+
+        return result;
+    }
+
+    quoneq_ftp_stat result = quoneq_ftp_client::perform_stat(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        ftp_url,
+        username,
+        password
     );
 
-    if(!username.empty())
-        curl_easy_setopt(curl, CURLOPT_USERNAME, username.c_str());
+    quoneq_net::cleanup_handle(curl);
+    return result;
+}
 
-    if(!password.empty())
-        curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
+bool quoneq_ftp_client::exists(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    return quoneq_ftp_client::stat(ftp_url, username, password).exists;
+}
 
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
-    else {
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response->responseCode);
-        response->content = data;
+bool quoneq_ftp_client::is_file(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    auto info = quoneq_ftp_client::stat(ftp_url, username, password);
+    return info.exists && info.entry.type == quoneq_ftp_entry_type::file;
+}
+
+bool quoneq_ftp_client::is_folder(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    auto info = quoneq_ftp_client::stat(ftp_url, username, password);
+    return info.exists && info.entry.type == quoneq_ftp_entry_type::directory;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::create(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
     }
 
-    curl_easy_cleanup(curl);
+    std::string path = quoneq_ftp_client::command_path(ftp_url);
+    auto response = quoneq_ftp_client::perform_commands(
+        curl,
+        ftp_url,
+        { "MKD " + path },
+        username,
+        password
+    );
+
+    quoneq_net::cleanup_handle(curl);
     return response;
 }
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::file_info(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    return quoneq_ftp_client::read(ftp_url, username, password);
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_client::folder_info(
+    const std::string &ftp_url,
+    const std::string &username,
+    const std::string &password
+) {
+    return quoneq_ftp_client::read(ftp_url, username, password);
+}
@@ -0,0 +1,438 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/ftp_listing.hpp>
+
+#include <cctype>
+#include <charconv>
+
+/**
+ * @brief Returns the next whitespace-separated token and advances past it.
+ */
+static std::string_view next_token(std::string_view line, size_t &pos) {
+    while(pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+        pos++;
+
+    size_t start = pos;
+    while(pos < line.size() && line[pos] != ' ' && line[pos] != '\t')
+        pos++;
+
+    return line.substr(start, pos - start);
+}
+
+/**
+ * @brief Parses a run of decimal digits.
+ *
+ * @return true if the whole text was a number.
+ */
+template <typename T>
+static bool parse_number(std::string_view text, T &value) {
+    if(text.empty())
+        return false;
+
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+/**
+ * @brief Compares two strings case-insensitively.
+ */
+static bool same_text(std::string_view left, std::string_view right) {
+    if(left.size() != right.size())
+        return false;
+
+    for(size_t i = 0; i < left.size(); i++)
+        if(std::tolower(static_cast<unsigned char>(left[i])) !=
+            std::tolower(static_cast<unsigned char>(right[i])))
+            return false;
+
+    return true;
+}
+
+/**
+ * @brief Returns the month (1-12) named by a three-letter abbreviation, or 0.
+ */
+static int month_number(std::string_view name) {
+    static constexpr std::string_view months[] = {
+        "jan", "feb", "mar", "apr", "may", "jun",
+        "jul", "aug", "sep", "oct", "nov", "dec"
+    };
+
+    for(int i = 0; i < 12; i++)
+        if(same_text(name, months[i]))
+            return i + 1;
+
+    return 0;
+}
+
+/**
+ * @brief Converts an "rwxr-xr-x" permission string to POSIX mode bits.
+ */
+static std::uint16_t mode_bits(std::string_view perms) {
+    std::uint16_t mode = 0;
+    if(perms.size() < 9)
+        return mode;
+
+    for(size_t i = 0; i < 9; i++) {
+        char flag = perms[i];
+        if(flag != '-' && flag != 'S' && flag != 'T')
+            mode = static_cast<std::uint16_t>(mode | (1u << (8 - i)));
+    }
+
+    return mode;
+}
+
+/**
+ * @brief Parses an "HH:MM" time of day.
+ */
+static bool parse_clock(std::string_view text, int &hour, int &minute) {
+    size_t colon = text.find(':');
+    if(colon == std::string_view::npos)
+        return false;
+
+    return parse_number(text.substr(0, colon), hour) &&
+        parse_number(text.substr(colon + 1, 2), minute);
+}
+
+std::time_t quoneq_ftp_listing::make_time(
+    int year,
+    int month,
+    int day,
+    int hour,
+    int minute,
+    int second
+) {
+    if(month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59 ||
+        second < 0 || second > 60)
+        return -1;
+
+    // Days from the civil date (proleptic Gregorian calendar) to 1970-01-01.
+    int y = year - (month <= 2 ? 1 : 0);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    std::int64_t days = static_cast<std::int64_t>(era) * 146097 + doe - 719468;
+
+    return static_cast<std::time_t>(
+        days * 86400 + hour * 3600 + minute * 60 + second
+    );
+}
+
+bool quoneq_ftp_listing::parse_unix_line(
+    std::string_view line,
+    quoneq_ftp_entry &entry,
+    std::time_t now
+) {
+    size_t pos = 0;
+    std::string_view perms = next_token(line, pos);
+
+    if(perms.size() < 10)
+        return false;
+
+    switch(perms[0]) {
+        case '-':
+            entry.type = quoneq_ftp_entry_type::file;
+            break;
+
+        case 'd':
+            entry.type = quoneq_ftp_entry_type::directory;
+            break;
+
+        case 'l':
+            entry.type = quoneq_ftp_entry_type::link;
+            break;
+
+        case 'b': case 'c': case 'p': case 's':
+            entry.type = quoneq_ftp_entry_type::other;
+            break;
+
+        default:
+            return false;
+    }
+
+    entry.permissions = mode_bits(perms.substr(1));
+
+    // Link count, owner and group precede the size, but servers drop the
+    // group (or both) freely; the month name is the reliable anchor. An
+    // owner or group can look like a month too ("may"), so a candidate only
+    // counts when a day and a time or year follow it.
+    std::string_view previous, token;
+    for(int column = 0; column < 6; column++) {
+        previous = token;
+        token = next_token(line, pos);
+
+        int month = month_number(token);
+        if(month == 0)
+            continue;
+
+        size_t after = pos;
+        int day = 0, hour = 0, minute = 0, year = 0;
+        if(!parse_number(next_token(line, after), day) || day < 1 || day > 31)
+            continue;
+
+        std::string_view stamp = next_token(line, after);
+        bool clock = parse_clock(stamp, hour, minute);
+        if(!clock && !parse_number(stamp, year))
+            continue;
+
+        pos = after;
+        if(clock) {
+            // Recent files show a time instead of a year; the date is
+            // within the last six months, so a future date means last year.
+            std::tm current{};
+            gmtime_r(&now, &current);
+
+            year = current.tm_year + 1900;
+            entry.modified = quoneq_ftp_listing::make_time(year, month, day, hour, minute, 0);
+            if(entry.modified > now + 86400)
+                entry.modified = quoneq_ftp_listing::make_time(year - 1, month, day, hour, minute, 0);
+        }
+        else entry.modified = quoneq_ftp_listing::make_time(year, month, day, 0, 0, 0);
+
+        std::int64_t size = 0;
+        if(parse_number(previous, size))
+            entry.size = size;
+
+        if(pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+            pos++;
+
+        std::string_view name = line.substr(pos);
+        if(entry.type == quoneq_ftp_entry_type::link) {
+            size_t arrow = name.find(" -> ");
+            if(arrow != std::string_view::npos)
+                name = name.substr(0, arrow);
+        }
+
+        if(name.empty())
+            return false;
+
+        entry.name = std::string(name);
+        return true;
+    }
+
+    return false;
+}
+
+bool quoneq_ftp_listing::parse_dos_line(
+    std::string_view line,
+    quoneq_ftp_entry &entry
+) {
+    size_t pos = 0;
+    std::string_view date = next_token(line, pos);
+    std::string_view clock = next_token(line, pos);
+    std::string_view kind = next_token(line, pos);
+
+    // The date is MM-DD-YY or MM-DD-YYYY, with '-' or '/' separators.
+    if(date.size() < 8 || (date[2] != '-' && date[2] != '/'))
+        return false;
+
+    int month = 0, day = 0, year = 0, hour = 0, minute = 0;
+    if(!parse_number(date.substr(0, 2), month) ||
+        !parse_number(date.substr(3, 2), day) ||
+        !parse_number(date.substr(6), year) ||
+        !parse_clock(clock, hour, minute))
+        return false;
+
+    if(year < 100)
+        year += year < 70 ? 2000 : 1900;
+
+    if(clock.size() >= 2) {
+        std::string_view meridiem = clock.substr(clock.size() - 2);
+        if(same_text(meridiem, "PM") && hour < 12)
+            hour += 12;
+        else if(same_text(meridiem, "AM") && hour == 12)
+            hour = 0;
+    }
+
+    std::int64_t size = 0;
+    if(same_text(kind, "<DIR>"))
+        entry.type = quoneq_ftp_entry_type::directory;
+    else if(parse_number(kind, size)) {
+        entry.type = quoneq_ftp_entry_type::file;
+        entry.size = size;
+    }
+    else return false;
+
+    while(pos < line.size() && (line[pos] == ' ' || line[pos] == '\t'))
+        pos++;
+
+    if(pos >= line.size())
+        return false;
+
+    entry.name = std::string(line.substr(pos));
+    entry.modified = quoneq_ftp_listing::make_time(year, month, day, hour, minute, 0);
+
+    return true;
+}
+
+bool quoneq_ftp_listing::parse_facts(
+    std::string_view line,
+    quoneq_ftp_entry &entry,
+    bool listing
+) {
+    // Facts end at the first space; everything after it is the name.
+    size_t space = line.find(' ');
+    if(space == std::string_view::npos || space + 1 >= line.size())
+        return false;
+
+    std::string_view facts = line.substr(0, space);
+    entry.name = std::string(line.substr(space + 1));
+
+    while(!facts.empty()) {
+        size_t end = facts.find(';');
+        std::string_view fact = facts.substr(0, end);
+        facts = end == std::string_view::npos
+            ? std::string_view()
+            : facts.substr(end + 1);
+
+        size_t equals = fact.find('=');
+        if(equals == std::string_view::npos)
+            continue;
+
+        std::string_view key = fact.substr(0, equals);
+        std::string_view value = fact.substr(equals + 1);
+
+        if(same_text(key, "type")) {
+            if(same_text(value, "file"))
+                entry.type = quoneq_ftp_entry_type::file;
+            else if(same_text(value, "dir") || same_text(value, "cdir") || same_text(value, "pdir"))
+                entry.type = quoneq_ftp_entry_type::directory;
+            else if((value.size() >= 13 && same_text(value.substr(0, 13), "OS.unix=slink")) ||
+                same_text(value, "OS.unix=symlink"))
+                entry.type = quoneq_ftp_entry_type::link;
+            else entry.type = quoneq_ftp_entry_type::other;
+
+            // The directory itself and its parent are not entries of a listing.
+            if(listing && (same_text(value, "cdir") || same_text(value, "pdir")))
+                return false;
+        }
+        else if(same_text(key, "size") || same_text(key, "sizd")) {
+            std::int64_t size = 0;
+            if(parse_number(value, size))
+                entry.size = size;
+        }
+        else if(same_text(key, "modify")) {
+            int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+            if(value.size() >= 14 &&
+                parse_number(value.substr(0, 4), year) &&
+                parse_number(value.substr(4, 2), month) &&
+                parse_number(value.substr(6, 2), day) &&
+                parse_number(value.substr(8, 2), hour) &&
+                parse_number(value.substr(10, 2), minute) &&
+                parse_number(value.substr(12, 2), second))
+                entry.modified = quoneq_ftp_listing::make_time(
+                    year, month, day,
+                    hour, minute, second
+                );
+        }
+        else if(same_text(key, "UNIX.mode")) {
+            unsigned int mode = 0;
+            auto result = std::from_chars(
+                value.data(),
+                value.data() + value.size(),
+                mode,
+                8
+            );
+
+            if(result.ec == std::errc())
+                entry.permissions = static_cast<std::uint16_t>(mode & 07777);
+        }
+        else if(same_text(key, "perm") && entry.permissions == 0) {
+            // RFC 3659 permissions describe what the logged-in user may do;
+            // map them onto the owner bits when no UNIX.mode is given.
+            for(char flag : value)
+                switch(std::tolower(static_cast<unsigned char>(flag))) {
+                    case 'r': case 'l':
+                        entry.permissions |= 0400;
+                        break;
+
+                    case 'w': case 'a': case 'c': case 'm':
+                        entry.permissions |= 0200;
+                        break;
+
+                    case 'e':
+                        entry.permissions |= 0100;
+                        break;
+
+                    default:
+                        break;
+                }
+        }
+    }
+
+    return !entry.name.empty();
+}
+
+bool quoneq_ftp_listing::parse_list_line(
+    std::string_view line,
+    quoneq_ftp_entry &entry,
+    std::time_t now
+) {
+    if(line.empty())
+        return false;
+
+    if(std::isdigit(static_cast<unsigned char>(line[0])))
+        return quoneq_ftp_listing::parse_dos_line(line, entry);
+
+    return quoneq_ftp_listing::parse_unix_line(line, entry, now);
+}
+
+bool quoneq_ftp_listing::safe_name(std::string_view name) {
+    if(name.empty() || name == "." || name == "..")
+        return false;
+
+    return name.find_first_of(std::string_view("/\\\0", 3)) == std::string_view::npos;
+}
+
+std::vector<quoneq_ftp_entry> quoneq_ftp_listing::parse(
+    std::string_view content,
+    bool machine
+) {
+    std::vector<quoneq_ftp_entry> entries;
+    std::time_t now = std::time(nullptr);
+
+    while(!content.empty()) {
+        size_t end = content.find('\n');
+        std::string_view line = content.substr(0, end);
+        content = end == std::string_view::npos
+            ? std::string_view()
+            : content.substr(end + 1);
+
+        if(!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        quoneq_ftp_entry entry;
+        bool parsed = machine
+            ? quoneq_ftp_listing::parse_facts(line, entry)
+            : quoneq_ftp_listing::parse_list_line(line, entry, now);
+
+        if(!parsed || !quoneq_ftp_listing::safe_name(entry.name))
+            continue;
+
+        entries.push_back(std::move(entry));
+    }
+
+    return entries;
+}
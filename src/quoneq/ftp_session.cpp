@@ -0,0 +1,362 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/ftp_session.hpp>
+#include <quoneq/net.hpp>
+
+quoneq_ftp_session::quoneq_ftp_session(
+    const std::string &server_url,
+    const std::string &user,
+    const std::string &pass
+) :
+    curl(curl_easy_init()),
+    root(server_url),
+    username(user),
+    password(pass),
+    operations(0),
+    connections(0),
+    control_port(0) {
+    quoneq_net::persist_handle(this->curl);
+
+    while(!this->root.empty() && this->root.back() == '/')
+        this->root.pop_back();
+}
+
+quoneq_ftp_session::~quoneq_ftp_session() {
+    if(this->curl)
+        quoneq_net::cleanup_handle(this->curl);
+}
+
+std::string quoneq_ftp_session::url(const std::string &path) const {
+    if(!path.empty() && path[0] == '/')
+        return this->root + path;
+
+    return this->root + "/" + path;
+}
+
+void quoneq_ftp_session::prepare() {
+    curl_easy_reset(this->curl);
+
+    // One CWD straight to the target directory instead of one per path
+    // component; libcurl skips it entirely when the directory is unchanged.
+    curl_easy_setopt(this->curl, CURLOPT_FTP_FILEMETHOD, CURLFTPMETHOD_SINGLECWD);
+    curl_easy_setopt(this->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+}
+
+void quoneq_ftp_session::track() {
+    long port = 0;
+    curl_easy_getinfo(this->curl, CURLINFO_LOCAL_PORT, &port);
+
+    // CURLINFO_NUM_CONNECTS also counts data connections, so a new control
+    // connection is recognised by its local port changing instead.
+    this->operations++;
+    if(port != 0 && port != this->control_port) {
+        this->control_port = port;
+        this->connections++;
+    }
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::upload(
+    const std::string &path,
+    const std::string &local_file
+) {
+    auto response = std::make_unique<quoneq_ftp_response>();
+    if(!this->curl) {
+        response->errorMessage = "Failed to initialize curl";
+        return response;
+    }
+
+    quoneq_upload_source source(local_file);
+    if(!source.is_open()) {
+        response->errorMessage = "Unable to open local file for reading";
+        return response;
+    }
+
+    this->prepare();
+    response = quoneq_ftp_client::perform_upload(
+        this->curl,
+        this->url(path),
+        &source,
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::upload(
+    const std::string &path,
+    std::span<const std::byte> data
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    quoneq_upload_source source(data);
+    this->prepare();
+
+    auto response = quoneq_ftp_client::perform_upload(
+        this->curl,
+        this->url(path),
+        &source,
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::download_file(
+    const std::string &path,
+    const std::string &local_file,
+    const quoneq_file_sink_options &sink_options
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    this->prepare();
+    auto response = quoneq_ftp_client::perform_download(
+        this->curl,
+        this->url(path),
+        local_file,
+        this->username,
+        this->password,
+        sink_options
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::read(
+    const std::string &path
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    this->prepare();
+    auto response = quoneq_ftp_client::perform_read(
+        this->curl,
+        this->url(path),
+        this->username,
+        this->password,
+        false
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::list(
+    const std::string &path
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    this->prepare();
+    auto response = quoneq_ftp_client::perform_read(
+        this->curl,
+        this->url(path),
+        this->username,
+        this->password,
+        true
+    );
+
+    if(response->errorMessage.empty())
+        response->list = quoneq_ftp_client::split_str(response->content, '\n');
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::list_entries(
+    const std::string &path
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    this->prepare();
+    auto response = quoneq_ftp_client::perform_list_entries(
+        this->curl,
+        this->url(path),
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::remove(
+    const std::string &path
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    std::string target = this->url(path);
+    this->prepare();
+
+    auto response = quoneq_ftp_client::perform_commands(
+        this->curl,
+        target,
+        { "DELE " + quoneq_ftp_client::command_path(target) },
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::move(
+    const std::string &path_from,
+    const std::string &path_to
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    std::string from = this->url(path_from), to = this->url(path_to);
+    this->prepare();
+
+    auto response = quoneq_ftp_client::perform_commands(
+        this->curl,
+        from,
+        {
+            "RNFR " + quoneq_ftp_client::command_path(from),
+            "RNTO " + quoneq_ftp_client::command_path(to)
+        },
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::create(
+    const std::string &path
+) {
+    if(!this->curl) {
+        auto response = std::make_unique<quoneq_ftp_response>();
+        response->errorMessage = "Failed to initialize curl";
+
+        return response;
+    }
+
+    std::string target = this->url(path);
+    this->prepare();
+
+    auto response = quoneq_ftp_client::perform_commands(
+        this->curl,
+        target,
+        { "MKD " + quoneq_ftp_client::command_path(target) },
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return response;
+}
+
+quoneq_ftp_stat quoneq_ftp_session::stat(const std::string &path) {
+    if(!this->curl) {
+        quoneq_ftp_stat result;
+        result.errorMessage = "Failed to initialize curl";
+
+        return result;
+    }
+
+    this->prepare();
+    quoneq_ftp_stat result = quoneq_ftp_client::perform_stat(
+        this->curl,
+        this->url(path),
+        this->username,
+        this->password
+    );
+
+    this->track();
+    return result;
+}
+
+bool quoneq_ftp_session::exists(const std::string &path) {
+    return this->stat(path).exists;
+}
+
+bool quoneq_ftp_session::is_file(const std::string &path) {
+    auto info = this->stat(path);
+    return info.exists && info.entry.type == quoneq_ftp_entry_type::file;
+}
+
+bool quoneq_ftp_session::is_folder(const std::string &path) {
+    auto info = this->stat(path);
+    return info.exists && info.entry.type == quoneq_ftp_entry_type::directory;
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::file_info(
+    const std::string &path
+) {
+    return this->read(path);
+}
+
+std::unique_ptr<quoneq_ftp_response> quoneq_ftp_session::folder_info(
+    const std::string &path
+) {
+    return this->read(path);
+}
+
+size_t quoneq_ftp_session::operation_count() const {
+    return this->operations;
+}
+
+size_t quoneq_ftp_session::connection_count() const {
+    return this->connections;
+}
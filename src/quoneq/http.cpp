@@ -21,21 +21,73 @@
  * THE SOFTWARE.
  */
 
+#include <quoneq/event_loop.hpp>
 #include <quoneq/http.hpp>
+#include <quoneq/http_cache.hpp>
 #include <quoneq/net.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 #include <fstream>
-#include <sstream>
+#include <limits>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::shared_ptr<quoneq_http_cache> quoneq_http_client::response_cache = nullptr;
+std::mutex quoneq_http_client::cache_lock;
+std::map<std::string, quoneq_http_client::flight> quoneq_http_client::flights = {};
+std::mutex quoneq_http_client::flight_lock;
+std::atomic<bool> quoneq_http_client::coalescing(false);
+quoneq_http_client::policy_counters quoneq_http_client::counters;
 
 size_t quoneq_http_client::write_callback(
     void* contents,
     size_t size,
     size_t nmemb,
-    std::string* output
+    quoneq_http_response* response
+) {
+    size_t total_size = size * nmemb;
+    std::string& content = response->content;
+
+    // Trust the announced length only up to 1 GiB; past that, let the
+    // buffer grow as the data actually arrives.
+    if(content.empty() && response->contentLength > content.capacity()) {
+        try {
+            content.reserve(std::min<size_t>(response->contentLength, 1UL << 30));
+        }
+        catch(const std::bad_alloc&) { }
+    }
+
+    content.append(static_cast<char*>(contents), total_size);
+    response->decodedLength += total_size;
+
+    return total_size;
+}
+
+size_t quoneq_http_client::stream_callback(
+    void* contents,
+    size_t size,
+    size_t nmemb,
+    stream_target* target
 ) {
     size_t total_size = size * nmemb;
-    output->append(static_cast<char*>(contents), total_size);
+    std::string_view chunk(static_cast<char*>(contents), total_size);
+
+    if(!(*target->sink)(chunk))
+        return 0;
+
+    target->response->decodedLength += total_size;
     return total_size;
 }
 
@@ -43,17 +95,504 @@ size_t quoneq_http_client::write_file_callback(
     void* contents,
     size_t size,
     size_t nmemb,
-    std::ofstream* file
+    file_download* download
 ) {
     size_t total_size = size * nmemb;
-    file->write(
-        (char*)contents,
-        static_cast<std::streamsize>(total_size)
-    );
+
+    if(!download->sized) {
+        curl_off_t length = -1;
+        curl_easy_getinfo(download->curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+
+        if(length > 0)
+            download->file->reserve(static_cast<size_t>(length));
+        download->sized = true;
+    }
+
+    if(!download->file->write(static_cast<const char*>(contents), total_size))
+        return 0;
+
+    return total_size;
+}
+
+size_t quoneq_http_client::segment_write_callback(
+    void* contents,
+    size_t size,
+    size_t nmemb,
+    download_segment* segment
+) {
+    size_t total_size = size * nmemb;
+    if(segment->response.status != 206 ||
+        total_size > segment->last + 1 - segment->offset)
+        return 0;
+
+    const char* data = static_cast<const char*>(contents);
+    size_t written = 0;
+
+    while(written < total_size) {
+        ssize_t result = pwrite(
+            segment->fd,
+            data + written,
+            total_size - written,
+            static_cast<off_t>(segment->offset + written)
+        );
+
+        if(result < 0) {
+            if(errno == EINTR)
+                continue;
+
+            segment->offset += written;
+            return 0;
+        }
+
+        written += static_cast<size_t>(result);
+    }
+
+    segment->offset += total_size;
+    return total_size;
+}
+
+static inline unsigned char ascii_lower(char c) {
+    unsigned char byte = static_cast<unsigned char>(c);
+    return (byte >= 'A' && byte <= 'Z') ?
+        static_cast<unsigned char>(byte | 0x20) : byte;
+}
+
+static inline bool equals_ignore_case(
+    std::string_view left,
+    std::string_view right
+) {
+    if(left.size() != right.size())
+        return false;
+
+    for(size_t i = 0; i < left.size(); i++)
+        if(ascii_lower(left[i]) != ascii_lower(right[i]))
+            return false;
+
+    return true;
+}
+
+static bool parse_content_range(
+    std::string_view value,
+    size_t* first,
+    size_t* length
+) {
+    constexpr std::string_view unit = "bytes ";
+    if(value.substr(0, unit.size()) != unit)
+        return false;
+
+    value.remove_prefix(unit.size());
+    size_t slash = value.find('/');
+
+    if(slash == std::string_view::npos)
+        return false;
+
+    std::string_view range = value.substr(0, slash);
+    std::string_view total = value.substr(slash + 1);
+
+    if(range == "*")
+        *first = std::string::npos;
+    else if(std::from_chars(
+        range.data(),
+        range.data() + range.size(),
+        *first
+    ).ec != std::errc())
+        return false;
+
+    return std::from_chars(
+        total.data(),
+        total.data() + total.size(),
+        *length
+    ).ec == std::errc();
+}
+
+bool quoneq_http_client::load_checkpoint(
+    const std::string& path,
+    download_checkpoint* checkpoint
+) {
+    std::ifstream file(path);
+    if(!file)
+        return false;
+
+    std::string line;
+    while(std::getline(file, line)) {
+        size_t separator = line.find(": ");
+        if(separator == std::string::npos)
+            continue;
+
+        std::string key = line.substr(0, separator);
+        std::string value = line.substr(separator + 2);
+
+        if(key == "url")
+            checkpoint->url = value;
+        else if(key == "etag")
+            checkpoint->etag = value;
+        else if(key == "last-modified")
+            checkpoint->lastModified = value;
+        else if(key == "length")
+            std::from_chars(value.data(), value.data() + value.size(), checkpoint->length);
+        else if(key == "offset")
+            std::from_chars(value.data(), value.data() + value.size(), checkpoint->offset);
+    }
+
+    return !checkpoint->url.empty();
+}
+
+void quoneq_http_client::save_checkpoint(
+    const std::string& path,
+    const download_checkpoint& checkpoint
+) {
+    const std::string staging = path + ".tmp";
+    {
+        std::ofstream file(staging, std::ios::trunc);
+        if(!file)
+            return;
+
+        file << "url: " << checkpoint.url << "\n"
+            << "etag: " << checkpoint.etag << "\n"
+            << "last-modified: " << checkpoint.lastModified << "\n"
+            << "length: " << checkpoint.length << "\n"
+            << "offset: " << checkpoint.offset << "\n";
+
+        if(!file)
+            return;
+    }
+
+    std::rename(staging.c_str(), path.c_str());
+}
+
+size_t quoneq_http_client::resume_write_callback(
+    void* contents,
+    size_t size,
+    size_t nmemb,
+    resume_download* download
+) {
+    // Flush and checkpoint at least this often, so that a crash loses at
+    // most this much progress.
+    constexpr size_t checkpoint_interval = 8UL << 20;
+
+    size_t total_size = size * nmemb;
+    quoneq_http_response* response = download->response;
+
+    if(!download->started) {
+        download->started = true;
+
+        if(response->status == 206) {
+            size_t first = 0, length = 0;
+
+            if(!parse_content_range(response->header.get("Content-Range"), &first, &length) ||
+                first != download->offset) {
+                download->error = "Unexpected Content-Range in resumed response";
+                return 0;
+            }
+
+            download->checkpoint.length = length;
+        }
+        else if(response->status == 200) {
+            if(ftruncate(download->fd, 0) != 0) {
+                download->error = "Unable to truncate output file";
+                return 0;
+            }
+
+            download->offset = 0;
+            download->checkpoint.length = response->contentLength;
+        }
+        else download->discard = true;
+
+        if(!download->discard) {
+            download->checkpoint.etag = std::string(response->header.get("ETag"));
+            download->checkpoint.lastModified = std::string(response->header.get("Last-Modified"));
+            download->checkpoint.offset = download->synced = download->offset;
+
+            quoneq_http_client::save_checkpoint(
+                download->checkpoint_path,
+                download->checkpoint
+            );
+        }
+    }
+
+    if(download->discard)
+        return total_size;
+
+    const char* data = static_cast<const char*>(contents);
+    size_t written = 0;
+
+    while(written < total_size) {
+        ssize_t result = pwrite(
+            download->fd,
+            data + written,
+            total_size - written,
+            static_cast<off_t>(download->offset + written)
+        );
+
+        if(result < 0) {
+            if(errno == EINTR)
+                continue;
+
+            download->offset += written;
+            download->error = "Unable to write output file";
+
+            return 0;
+        }
+
+        written += static_cast<size_t>(result);
+    }
+
+    download->offset += total_size;
+    if(download->offset - download->synced >= checkpoint_interval &&
+        fdatasync(download->fd) == 0) {
+        download->synced = download->checkpoint.offset = download->offset;
+        quoneq_http_client::save_checkpoint(
+            download->checkpoint_path,
+            download->checkpoint
+        );
+    }
 
     return total_size;
 }
 
+bool quoneq_http_header_less::operator()(
+    std::string_view left,
+    std::string_view right
+) const {
+    size_t length = std::min(left.size(), right.size());
+
+    for(size_t i = 0; i < length; i++) {
+        unsigned char a = ascii_lower(left[i]), b = ascii_lower(right[i]);
+        if(a != b)
+            return a < b;
+    }
+
+    return left.size() < right.size();
+}
+
+quoneq_http_headers::const_iterator::const_iterator() :
+    table(nullptr),
+    position(0),
+    field() { }
+
+quoneq_http_headers::const_iterator::const_iterator(
+    const quoneq_http_headers* headers,
+    size_t index
+) :
+    table(headers),
+    position(index),
+    field() {
+    this->load();
+}
+
+void quoneq_http_headers::const_iterator::load() {
+    if(!this->table || this->position >= this->table->entries.size()) {
+        this->field = {};
+        return;
+    }
+
+    const entry& current = this->table->entries[this->position];
+    std::string_view arena_view = this->table->arena;
+
+    this->field = {
+        arena_view.substr(current.key_offset, current.key_length),
+        arena_view.substr(current.value_offset, current.value_length)
+    };
+}
+
+quoneq_http_headers::value_type quoneq_http_headers::const_iterator::operator*() const {
+    return this->field;
+}
+
+quoneq_http_headers::const_iterator::pointer
+quoneq_http_headers::const_iterator::operator->() const {
+    return &this->field;
+}
+
+quoneq_http_headers::const_iterator& quoneq_http_headers::const_iterator::operator++() {
+    this->position++;
+    this->load();
+
+    return *this;
+}
+
+quoneq_http_headers::const_iterator quoneq_http_headers::const_iterator::operator++(int) {
+    const_iterator previous = *this;
+    ++*this;
+
+    return previous;
+}
+
+bool quoneq_http_headers::const_iterator::operator==(
+    const const_iterator& other
+) const {
+    return this->table == other.table &&
+        this->position == other.position;
+}
+
+void quoneq_http_headers::add(std::string_view key, std::string_view value) {
+    // Most responses fit in these, so a full header block normally
+    // costs exactly two allocations.
+    if(this->entries.capacity() == 0) {
+        this->arena.reserve(1024);
+        this->entries.reserve(32);
+    }
+
+    entry field;
+    field.key_offset = static_cast<uint32_t>(this->arena.size());
+    field.key_length = static_cast<uint32_t>(key.size());
+    this->arena.append(key);
+
+    field.value_offset = static_cast<uint32_t>(this->arena.size());
+    field.value_length = static_cast<uint32_t>(value.size());
+    this->arena.append(value);
+
+    this->entries.push_back(field);
+}
+
+void quoneq_http_headers::clear() {
+    this->arena.clear();
+    this->entries.clear();
+}
+
+size_t quoneq_http_headers::size() const {
+    return this->entries.size();
+}
+
+bool quoneq_http_headers::empty() const {
+    return this->entries.empty();
+}
+
+bool quoneq_http_headers::contains(std::string_view key) const {
+    for(const auto& field : *this)
+        if(equals_ignore_case(field.first, key))
+            return true;
+
+    return false;
+}
+
+std::string_view quoneq_http_headers::get(std::string_view key) const {
+    for(const auto& field : *this)
+        if(equals_ignore_case(field.first, key))
+            return field.second;
+
+    return {};
+}
+
+std::vector<std::string_view> quoneq_http_headers::get_all(
+    std::string_view key
+) const {
+    std::vector<std::string_view> values;
+
+    for(const auto& field : *this)
+        if(equals_ignore_case(field.first, key))
+            values.push_back(field.second);
+
+    return values;
+}
+
+size_t quoneq_http_headers::count(std::string_view key) const {
+    size_t matches = 0;
+
+    for(const auto& field : *this)
+        if(equals_ignore_case(field.first, key))
+            matches++;
+
+    return matches;
+}
+
+quoneq_http_headers::const_iterator quoneq_http_headers::find(std::string_view key) const {
+    for(auto it = this->begin(); it != this->end(); ++it)
+        if(equals_ignore_case(it->first, key))
+            return it;
+
+    return this->end();
+}
+
+const std::string quoneq_http_headers::operator[](std::string_view key) const {
+    return std::string(this->get(key));
+}
+
+std::string quoneq_http_headers::at(std::string_view key) const {
+    auto found = this->find(key);
+    if(found == this->end())
+        throw std::out_of_range("No header field named " + std::string(key));
+
+    return std::string(found->second);
+}
+
+quoneq_http_headers::const_iterator quoneq_http_headers::begin() const {
+    return const_iterator(this, 0);
+}
+
+quoneq_http_headers::const_iterator quoneq_http_headers::end() const {
+    return const_iterator(this, this->entries.size());
+}
+
+std::map<std::string, std::string, quoneq_http_header_less>
+quoneq_http_headers::to_map() const {
+    std::map<std::string, std::string, quoneq_http_header_less> map;
+
+    for(const auto& field : *this) {
+        auto existing = map.find(field.first);
+
+        if(existing == map.end())
+            map.emplace(field.first, field.second);
+        else existing->second.append(", ").append(field.second);
+    }
+
+    return map;
+}
+
+std::string_view quoneq_http_client::trim(std::string_view text) {
+    const char* whitespace = " \t\r\n";
+
+    size_t start = text.find_first_not_of(whitespace);
+    if(start == std::string_view::npos)
+        return {};
+
+    size_t end = text.find_last_not_of(whitespace);
+    return text.substr(start, end - start + 1);
+}
+
+void quoneq_http_client::parse_status_line(
+    std::string_view line,
+    quoneq_http_response* response
+) {
+    size_t code_start = line.find(' ');
+    if(code_start == std::string_view::npos)
+        return;
+
+    std::string_view rest = quoneq_http_client::trim(line.substr(code_start));
+    unsigned int code = 0;
+
+    auto parsed = std::from_chars(rest.data(), rest.data() + rest.size(), code);
+    if(parsed.ec != std::errc())
+        return;
+
+    response->status = static_cast<uint16_t>(code);
+    response->statusType = quoneq_http_client::trim(
+        rest.substr(static_cast<size_t>(parsed.ptr - rest.data()))
+    );
+    response->contentLength = 0;
+    response->header.clear();
+}
+
+void quoneq_http_client::parse_cookie(
+    std::string_view value,
+    quoneq_http_response* response
+) {
+    std::string_view pair = value.substr(0, value.find(';'));
+    size_t equals_pos = pair.find('=');
+
+    if(equals_pos == std::string_view::npos)
+        return;
+
+    std::string_view name = quoneq_http_client::trim(pair.substr(0, equals_pos));
+    if(name.empty())
+        return;
+
+    response->cookies.add(
+        name,
+        quoneq_http_client::trim(pair.substr(equals_pos + 1))
+    );
+}
+
 size_t quoneq_http_client::header_callback(
     void* contents,
     size_t size,
@@ -61,224 +600,1449 @@ size_t quoneq_http_client::header_callback(
     quoneq_http_response* response
 ) {
     size_t total_size = size * nmemb;
-    std::string header_line(static_cast<char*>(contents), total_size);
+    std::string_view line = quoneq_http_client::trim(
+        std::string_view(static_cast<char*>(contents), total_size)
+    );
+
+    if(line.starts_with("HTTP/")) {
+        quoneq_http_client::parse_status_line(line, response);
+        return total_size;
+    }
+
+    size_t delimiter_pos = line.find(':');
+    if(delimiter_pos == std::string_view::npos || delimiter_pos == 0)
+        return total_size;
+
+    std::string_view key = quoneq_http_client::trim(line.substr(0, delimiter_pos));
+    std::string_view value = quoneq_http_client::trim(line.substr(delimiter_pos + 1));
+
+    if(equals_ignore_case(key, "Set-Cookie")) {
+        quoneq_http_client::parse_cookie(value, response);
+        return total_size;
+    }
+
+    if(equals_ignore_case(key, "Content-Length"))
+        std::from_chars(
+            value.data(),
+            value.data() + value.size(),
+            response->contentLength
+        );
+
+    response->header.add(key, value);
+
+    return total_size;
+}
+
+struct curl_slist* quoneq_http_client::prepare_headers(
+    const std::map<std::string, std::string>& headers
+) {
+    struct curl_slist* curl_headers = nullptr;
+
+    for(const auto& header : headers) {
+        std::string header_str = header.first + ": " + header.second;
+        curl_headers = curl_slist_append(
+            curl_headers,
+            header_str.c_str()
+        );
+    }
+    return curl_headers;
+}
+
+std::string quoneq_http_client::prepare_cookies(
+    const std::map<std::string, std::string>& cookies
+) {
+    std::string cookie_str;
+
+    for(const auto& cookie : cookies) {
+        if(!cookie_str.empty())
+            cookie_str += "; ";
+        cookie_str += cookie.first + "=" + cookie.second;
+    }
+    return cookie_str;
+}
+
+size_t quoneq_http_client::read_source_callback(
+    char* buffer,
+    size_t size,
+    size_t nitems,
+    void* source
+) {
+    return static_cast<quoneq_upload_source*>(source)->read(buffer, size * nitems);
+}
+
+size_t quoneq_http_client::read_body_callback(
+    char* buffer,
+    size_t size,
+    size_t nitems,
+    body_upload* upload
+) {
+    if(!upload->encoder)
+        return upload->source(buffer, size * nitems);
+
+    size_t length = upload->encoder->read(buffer, size * nitems, upload->source);
+    if(upload->encoder->has_failed())
+        return CURL_READFUNC_ABORT;
+
+    return length;
+}
+
+int quoneq_http_client::seek_source_callback(
+    void* source,
+    curl_off_t offset,
+    int origin
+) {
+    if(origin != SEEK_SET || offset < 0)
+        return CURL_SEEKFUNC_CANTSEEK;
+
+    return static_cast<quoneq_upload_source*>(source)->seek(static_cast<size_t>(offset))
+        ? CURL_SEEKFUNC_OK
+        : CURL_SEEKFUNC_FAIL;
+}
+
+void quoneq_http_client::free_source_callback(void* source) {
+    delete static_cast<quoneq_upload_source*>(source);
+}
+
+curl_mime* quoneq_http_client::prepare_form(
+    CURL* curl,
+    const std::map<std::string, std::string>& form,
+    const std::map<std::string, std::string>& files
+) {
+    curl_mime* mime = curl_mime_init(curl);
+    for(const auto& field : form) {
+        curl_mimepart* part = curl_mime_addpart(mime);
+        curl_mime_name(part, field.first.c_str());
+        curl_mime_data(part, field.second.c_str(), CURL_ZERO_TERMINATED);
+    }
+
+    for(const auto& file : files) {
+        curl_mimepart* part = curl_mime_addpart(mime);
+        curl_mime_name(part, file.first.c_str());
+
+        auto source = std::make_unique<quoneq_upload_source>(file.second);
+        if(source->is_open()) {
+            curl_off_t length = static_cast<curl_off_t>(source->size());
+            curl_mime_data_cb(
+                part,
+                length,
+                quoneq_http_client::read_source_callback,
+                quoneq_http_client::seek_source_callback,
+                quoneq_http_client::free_source_callback,
+                source.release()
+            );
+        }
+        else curl_mime_filedata(part, file.second.c_str());
+
+        std::string filename = file.second.substr(
+            file.second.find_last_of("/\\") + 1
+        );
+        curl_mime_filename(part, filename.c_str());
+    }
+
+    return mime;
+}
+
+void quoneq_http_client::prepare_request(
+    CURL* curl,
+    const quoneq_http_request& request,
+    quoneq_http_response* response,
+    struct curl_slist** header_list,
+    curl_mime** mime
+) {
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+    quoneq_net::attach_share(curl);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, quoneq_http_client::header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, response);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    quoneq_net::apply_ca_cert(curl);
+
+    if(request.method == "HEAD")
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    else if(request.method == "POST")
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    else if(request.method != "GET")
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, request.method.c_str());
+
+    *header_list = quoneq_http_client::prepare_headers(request.headers);
+    if(*header_list)
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, *header_list);
+
+    std::string cookie_str = quoneq_http_client::prepare_cookies(request.cookies);
+    if(!cookie_str.empty())
+        curl_easy_setopt(curl, CURLOPT_COOKIE, cookie_str.c_str());
+
+    *mime = nullptr;
+    if(request.method == "POST" || !request.form.empty() || !request.files.empty()) {
+        *mime = quoneq_http_client::prepare_form(
+            curl,
+            request.form,
+            request.files
+        );
+        curl_easy_setopt(curl, CURLOPT_MIMEPOST, *mime);
+    }
+
+    if(!request.proxy.empty())
+        curl_easy_setopt(curl, CURLOPT_PROXY, request.proxy.c_str());
+
+    if(!request.username.empty() && !request.password.empty()) {
+        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
+        curl_easy_setopt(
+            curl,
+            CURLOPT_USERPWD,
+            (request.username + ":" + request.password).c_str()
+        );
+    }
+
+    // An empty string offers every coding libcurl was built with and
+    // decodes the body before it reaches the write callback.
+    if(request.compressed)
+        curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
+
+    quoneq_http_client::apply_policy(curl, request.policy);
+}
+
+void quoneq_http_client::apply_policy(CURL* curl, const quoneq_http_policy& policy) {
+    if(policy.connectTimeoutMs > 0)
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, policy.connectTimeoutMs);
+
+    if(policy.timeoutMs > 0)
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, policy.timeoutMs);
+
+    if(policy.lowSpeedLimit > 0 && policy.lowSpeedTime > 0) {
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, policy.lowSpeedLimit);
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, policy.lowSpeedTime);
+    }
+}
+
+void quoneq_http_client::record_timeout(
+    CURL* curl,
+    CURLcode result,
+    const quoneq_http_policy& policy
+) {
+    if(result != CURLE_OPERATION_TIMEDOUT)
+        return;
+
+    // libcurl reports all three aborts with the same code, so they are told
+    // apart by how far the transfer got.
+    curl_off_t connected = 0, elapsed = 0;
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connected);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &elapsed);
+
+    // The total timeout fires on a timer tick, so the measured time may
+    // fall slightly short of it.
+    bool low_speed = policy.lowSpeedLimit > 0 && policy.lowSpeedTime > 0;
+    bool deadline = policy.timeoutMs > 0 && elapsed / 1000 + 50 >= policy.timeoutMs;
+
+    if(connected == 0)
+        quoneq_http_client::counters.connectTimeouts++;
+    else if(deadline || !low_speed)
+        quoneq_http_client::counters.totalTimeouts++;
+    else quoneq_http_client::counters.lowSpeedAborts++;
+}
+
+bool quoneq_http_client::retry_delay(
+    const quoneq_http_request& request,
+    const quoneq_http_response& response,
+    CURLcode result,
+    unsigned attempt,
+    long* delay_ms
+) {
+    const quoneq_http_policy& policy = request.policy;
+
+    bool retryable = false;
+    if(result == CURLE_OK)
+        retryable = std::find(
+            policy.retryStatuses.begin(),
+            policy.retryStatuses.end(),
+            response.status
+        ) != policy.retryStatuses.end();
+    else retryable = result == CURLE_COULDNT_RESOLVE_HOST ||
+        result == CURLE_COULDNT_CONNECT ||
+        result == CURLE_OPERATION_TIMEDOUT ||
+        result == CURLE_SSL_CONNECT_ERROR ||
+        result == CURLE_SEND_ERROR ||
+        result == CURLE_RECV_ERROR ||
+        result == CURLE_GOT_NOTHING ||
+        result == CURLE_PARTIAL_FILE ||
+        result == CURLE_HTTP2 ||
+        result == CURLE_HTTP2_STREAM;
+
+    if(!retryable)
+        return false;
+
+    bool idempotent = request.method == "GET" || request.method == "HEAD" ||
+        request.method == "PUT" || request.method == "DELETE" ||
+        request.method == "OPTIONS";
+
+    if(!idempotent && !policy.retryNonIdempotent)
+        return false;
+
+    if(attempt >= policy.maxRetries) {
+        if(policy.maxRetries > 0)
+            quoneq_http_client::counters.exhausted++;
+
+        return false;
+    }
+
+    // Retry-After is either a number of seconds or an HTTP date. A server
+    // asking for a longer pause than the policy allows is not retried, and
+    // the request counts as having run out of retries.
+    std::string_view retry_after = response.header.get("Retry-After");
+    if(!retry_after.empty() && (response.status == 429 || response.status == 503)) {
+        long seconds = -1;
+        auto parsed = std::from_chars(
+            retry_after.data(),
+            retry_after.data() + retry_after.size(),
+            seconds
+        );
+
+        // A number of seconds too large for a long is still a number, and
+        // certainly above the cap
+        if(parsed.ec == std::errc::result_out_of_range &&
+            parsed.ptr == retry_after.data() + retry_after.size())
+            seconds = std::numeric_limits<long>::max();
+        else if(parsed.ec != std::errc() || parsed.ptr != retry_after.data() + retry_after.size()) {
+            std::time_t date = curl_getdate(std::string(retry_after).c_str(), nullptr);
+            seconds = date < 0 ? -1 : std::max(0L, static_cast<long>(date - std::time(nullptr)));
+        }
+
+        if(seconds >= 0) {
+            // Compared in seconds, as a huge Retry-After would overflow
+            // once converted to milliseconds
+            if(seconds > policy.backoffMaxMs / 1000) {
+                quoneq_http_client::counters.exhausted++;
+                return false;
+            }
+
+            *delay_ms = seconds * 1000;
+            quoneq_http_client::counters.retryAfterWaits++;
+
+            return true;
+        }
+    }
+
+    *delay_ms = quoneq_http_client::backoff_delay(policy, attempt);
+    return true;
+}
+
+long quoneq_http_client::backoff_delay(const quoneq_http_policy& policy, unsigned attempt) {
+    // Exponential backoff with full jitter, so that clients failing together
+    // do not retry together.
+    long ceiling = policy.backoffMaxMs;
+    if(attempt < 30)
+        ceiling = std::min(policy.backoffBaseMs * (1L << attempt), policy.backoffMaxMs);
+
+    thread_local std::mt19937 generator(std::random_device{}());
+    std::uniform_int_distribution<long> jitter(0, std::max(ceiling, 0L));
+
+    return jitter(generator);
+}
+
+quoneq_http_policy_stats quoneq_http_client::policy_stats() {
+    quoneq_http_policy_stats stats;
+    stats.connectTimeouts = quoneq_http_client::counters.connectTimeouts;
+    stats.totalTimeouts = quoneq_http_client::counters.totalTimeouts;
+    stats.lowSpeedAborts = quoneq_http_client::counters.lowSpeedAborts;
+    stats.retries = quoneq_http_client::counters.retries;
+    stats.retryAfterWaits = quoneq_http_client::counters.retryAfterWaits;
+    stats.exhausted = quoneq_http_client::counters.exhausted;
+
+    return stats;
+}
+
+void quoneq_http_client::read_transfer_info(
+    CURL* curl,
+    quoneq_http_response* response
+) {
+    curl_off_t received = 0;
+    if(curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &received) == CURLE_OK &&
+        received > 0)
+        response->wireLength = static_cast<size_t>(received);
+
+    auto microseconds = [curl](CURLINFO info) {
+        curl_off_t value = 0;
+        curl_easy_getinfo(curl, info, &value);
+
+        return std::chrono::microseconds(value);
+    };
+
+    response->timing.nameLookup = microseconds(CURLINFO_NAMELOOKUP_TIME_T);
+    response->timing.connect = microseconds(CURLINFO_CONNECT_TIME_T);
+    response->timing.appConnect = microseconds(CURLINFO_APPCONNECT_TIME_T);
+    response->timing.preTransfer = microseconds(CURLINFO_PRETRANSFER_TIME_T);
+    response->timing.firstByte = microseconds(CURLINFO_STARTTRANSFER_TIME_T);
+    response->timing.total = microseconds(CURLINFO_TOTAL_TIME_T);
+
+    curl_off_t uploaded = 0;
+    long request_size = 0, header_size = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &uploaded);
+    curl_easy_getinfo(curl, CURLINFO_REQUEST_SIZE, &request_size);
+    curl_easy_getinfo(curl, CURLINFO_HEADER_SIZE, &header_size);
+
+    response->bytesSent = static_cast<size_t>(std::max<curl_off_t>(uploaded, 0) + request_size);
+    response->bytesReceived = static_cast<size_t>(std::max<curl_off_t>(received, 0) + header_size);
+
+    // A request that got an answer without opening a connection used one
+    // left over from an earlier transfer.
+    long response_code = 0, new_connections = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &new_connections);
+    response->connectionReused = response_code != 0 && new_connections == 0;
+
+    long version = CURL_HTTP_VERSION_NONE;
+    if(curl_easy_getinfo(curl, CURLINFO_HTTP_VERSION, &version) != CURLE_OK)
+        return;
+
+    switch(version) {
+        case CURL_HTTP_VERSION_1_0:
+            response->httpVersion = "HTTP/1.0";
+            break;
+
+        case CURL_HTTP_VERSION_1_1:
+            response->httpVersion = "HTTP/1.1";
+            break;
+
+        case CURL_HTTP_VERSION_2_0:
+            response->httpVersion = "HTTP/2";
+            break;
+
+        case CURL_HTTP_VERSION_3:
+            response->httpVersion = "HTTP/3";
+            break;
+
+        default:
+            break;
+    }
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform(
+    CURL* curl,
+    const quoneq_http_request& request
+) {
+    for(unsigned attempt = 0;; attempt++) {
+        auto response = std::make_unique<quoneq_http_response>();
+
+        struct curl_slist* header_list = nullptr;
+        curl_mime* mime = nullptr;
+
+        quoneq_http_client::prepare_request(
+            curl,
+            request,
+            response.get(),
+            &header_list,
+            &mime
+        );
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, response.get());
+
+        CURLcode res = curl_easy_perform(curl);
+        quoneq_http_client::read_transfer_info(curl, response.get());
+        quoneq_http_client::record_timeout(curl, res, request.policy);
+        if(res != CURLE_OK) {
+            response->errorMessage = curl_easy_strerror(res);
+            response->content.clear();
+        }
+
+        curl_slist_free_all(header_list);
+        curl_mime_free(mime);
+
+        long delay_ms = 0;
+        if(!quoneq_http_client::retry_delay(request, *response, res, attempt, &delay_ms))
+            return response;
+
+        quoneq_http_client::counters.retries++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    }
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform_stream(
+    CURL* curl,
+    const quoneq_http_request& request,
+    const quoneq_http_sink& sink
+) {
+    auto response = std::make_unique<quoneq_http_response>();
+
+    struct curl_slist* header_list = nullptr;
+    curl_mime* mime = nullptr;
+
+    quoneq_http_client::prepare_request(
+        curl,
+        request,
+        response.get(),
+        &header_list,
+        &mime
+    );
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::stream_callback);
+    stream_target target;
+    target.sink = &sink;
+    target.response = response.get();
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &target);
+
+    CURLcode res = curl_easy_perform(curl);
+    quoneq_http_client::read_transfer_info(curl, response.get());
+    if(res != CURLE_OK)
+        response->errorMessage = curl_easy_strerror(res);
+
+    curl_slist_free_all(header_list);
+    curl_mime_free(mime);
+
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform_body(
+    CURL* curl,
+    const quoneq_http_request& request,
+    const quoneq_http_body& body
+) {
+    auto response = std::make_unique<quoneq_http_response>();
+
+    std::unique_ptr<quoneq_body_encoder> encoder;
+    if(body.encoding != quoneq_http_encoding::identity) {
+        encoder = std::make_unique<quoneq_body_encoder>(body.encoding, body.level);
+
+        if(!encoder->is_ready()) {
+            response->errorMessage = std::string(quoneq_body_encoder::token(body.encoding)) +
+                " request compression is not available";
+            return response;
+        }
+    }
+
+    // The body replaces the form, so the request is prepared as a plain
+    // GET and switched to POST afterwards.
+    quoneq_http_request raw = request;
+    raw.method = "GET";
+    raw.form.clear();
+    raw.files.clear();
+
+    // Header names are matched case-insensitively, so a header the caller
+    // set explicitly always takes precedence.
+    auto add_header = [&raw](const std::string& name, const std::string& value) {
+        for(const auto& [key, existing] : raw.headers)
+            if(equals_ignore_case(key, name))
+                return;
+
+        raw.headers.emplace(name, value);
+    };
+
+    add_header("Content-Type", body.contentType);
+    if(encoder)
+        add_header("Content-Encoding", quoneq_body_encoder::token(body.encoding));
+
+    bool streamed = body.reader || encoder;
+    if(streamed)
+        add_header("Transfer-Encoding", "chunked");
+
+    struct curl_slist* header_list = nullptr;
+    curl_mime* mime = nullptr;
+
+    quoneq_http_client::prepare_request(
+        curl,
+        raw,
+        response.get(),
+        &header_list,
+        &mime
+    );
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, response.get());
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+
+    size_t offset = 0;
+    body_upload upload;
+    upload.encoder = encoder.get();
+
+    if(body.reader)
+        upload.source = body.reader;
+    else upload.source = [&body, &offset](char* buffer, size_t capacity) {
+        size_t length = std::min(capacity, body.data.size() - offset);
+        if(length > 0)
+            std::memcpy(buffer, body.data.data() + offset, length);
+
+        offset += length;
+        return length;
+    };
+
+    if(streamed) {
+        curl_easy_setopt(curl, CURLOPT_READFUNCTION, quoneq_http_client::read_body_callback);
+        curl_easy_setopt(curl, CURLOPT_READDATA, &upload);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(-1));
+    }
+    else {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data.data());
+        curl_easy_setopt(
+            curl,
+            CURLOPT_POSTFIELDSIZE_LARGE,
+            static_cast<curl_off_t>(body.data.size())
+        );
+    }
+
+    CURLcode res = curl_easy_perform(curl);
+    quoneq_http_client::read_transfer_info(curl, response.get());
+    if(res != CURLE_OK) {
+        response->errorMessage = curl_easy_strerror(res);
+        response->content.clear();
+    }
+
+    curl_slist_free_all(header_list);
+    curl_mime_free(mime);
+
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform_ping(
+    CURL* curl,
+    const quoneq_http_request& request
+) {
+    auto response = std::make_unique<quoneq_http_response>();
+
+    curl_easy_setopt(curl, CURLOPT_URL, request.url.c_str());
+    quoneq_net::attach_share(curl);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, response.get());
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, quoneq_http_client::header_callback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, response.get());
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
+    quoneq_net::apply_ca_cert(curl);
+
+    if(!request.proxy.empty())
+        curl_easy_setopt(curl, CURLOPT_PROXY, request.proxy.c_str());
+
+    if(!request.username.empty() && !request.password.empty()) {
+        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
+        curl_easy_setopt(
+            curl,
+            CURLOPT_USERPWD,
+            (request.username + ":" + request.password).c_str()
+        );
+    }
+
+    CURLcode res = curl_easy_perform(curl);
+    quoneq_http_client::read_transfer_info(curl, response.get());
+
+    if(res == CURLE_OK) {
+        long response_code;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+        response->status = static_cast<uint16_t>(response_code);
+
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(response->timing.total);
+        response->content = std::to_string(duration.count()) + " ms";
+    }
+    else {
+        response->status = 0;
+        response->content = curl_easy_strerror(res);
+    }
+
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform_download_file(
+    CURL* curl,
+    const quoneq_http_request& request,
+    const std::string& out_filename,
+    const quoneq_file_sink_options& sink_options
+) {
+    auto response = std::make_unique<quoneq_http_response>();
+    quoneq_file_sink output_file(out_filename, sink_options);
+
+    if(!output_file.is_open()) {
+        response->errorMessage = "Unable to open output file";
+        return response;
+    }
+
+    file_download download;
+    download.curl = curl;
+    download.file = &output_file;
+
+    struct curl_slist* header_list = nullptr;
+    curl_mime* mime = nullptr;
+
+    quoneq_http_client::prepare_request(
+        curl,
+        request,
+        response.get(),
+        &header_list,
+        &mime
+    );
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_file_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &download);
+
+    CURLcode res = curl_easy_perform(curl);
+    quoneq_http_client::read_transfer_info(curl, response.get());
+    quoneq_http_client::record_timeout(curl, res, request.policy);
+    long http_code = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+    response->status = static_cast<uint16_t>(http_code);
+
+    bool stored = output_file.close();
+    response->decodedLength = output_file.size();
+    if(res == CURLE_WRITE_ERROR && !stored)
+        response->errorMessage = output_file.error();
+    else if(res != CURLE_OK)
+        response->errorMessage = curl_easy_strerror(res);
+    else if(!stored)
+        response->errorMessage = output_file.error();
+
+    curl_slist_free_all(header_list);
+    curl_mime_free(mime);
+
+    return response;
+}
+
+void quoneq_http_client::prepare_segment(
+    download_segment* segment,
+    const quoneq_http_request& request
+) {
+    curl_slist_free_all(segment->header_list);
+    curl_mime_free(segment->mime);
+    curl_easy_reset(segment->curl);
+
+    segment->response = quoneq_http_response();
+    segment->attempts++;
+
+    quoneq_http_client::prepare_request(
+        segment->curl,
+        request,
+        &segment->response,
+        &segment->header_list,
+        &segment->mime
+    );
+
+    std::string range = std::to_string(segment->offset) + "-" +
+        std::to_string(segment->last);
+    curl_easy_setopt(segment->curl, CURLOPT_RANGE, range.c_str());
+    curl_easy_setopt(segment->curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::segment_write_callback);
+    curl_easy_setopt(segment->curl, CURLOPT_WRITEDATA, segment);
+    curl_easy_setopt(segment->curl, CURLOPT_PRIVATE, segment);
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform_download_segmented(
+    CURL* curl,
+    const quoneq_http_request& request,
+    const std::string& out_filename,
+    size_t segments,
+    size_t max_retries
+) {
+    // Ranges smaller than this gain nothing from a connection of their own.
+    constexpr size_t segment_min_size = 1UL << 20;
+
+    auto response = std::make_unique<quoneq_http_response>();
+    {
+        // The probe must reach the same resource as the ranges will, so it
+        // carries the request's headers, cookies, credentials and timeouts.
+        quoneq_http_request probe = request;
+        probe.method = "HEAD";
+
+        struct curl_slist* header_list = nullptr;
+        curl_mime* mime = nullptr;
+
+        quoneq_http_client::prepare_request(
+            curl,
+            probe,
+            response.get(),
+            &header_list,
+            &mime
+        );
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, response.get());
+
+        CURLcode res = curl_easy_perform(curl);
+        quoneq_http_client::read_transfer_info(curl, response.get());
+        quoneq_http_client::record_timeout(curl, res, request.policy);
+
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        response->status = res == CURLE_OK ? static_cast<uint16_t>(http_code) : 0;
+
+        curl_slist_free_all(header_list);
+        curl_mime_free(mime);
+    }
+    const size_t length = response->contentLength;
+
+    if(response->status != 200 ||
+        !equals_ignore_case(response->header.get("Accept-Ranges"), "bytes"))
+        segments = 1;
+    else segments = std::min(segments, length / segment_min_size);
+
+    if(segments < 2) {
+        curl_easy_reset(curl);
+        return quoneq_http_client::perform_download_file(
+            curl,
+            request,
+            out_filename,
+            {}
+        );
+    }
+
+    response->content.clear();
+
+    int fd = open(out_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0) {
+        response->errorMessage = "Unable to open output file";
+        return response;
+    }
+
+    if(posix_fallocate(fd, 0, static_cast<off_t>(length)) != 0 &&
+        ftruncate(fd, static_cast<off_t>(length)) != 0) {
+        response->errorMessage = "Unable to allocate output file";
+        close(fd);
+
+        return response;
+    }
+
+    CURLM* multi = curl_multi_init();
+    if(!multi) {
+        response->errorMessage = "Failed to initialize curl";
+        close(fd);
+
+        return response;
+    }
+    curl_multi_setopt(multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(segments));
+
+    std::vector<download_segment> parts(segments);
+    const size_t span = length / segments;
+    size_t remaining = 0;
+
+    for(size_t i = 0; i < segments; i++) {
+        download_segment& segment = parts[i];
+        segment.fd = fd;
+        segment.offset = i * span;
+        segment.last = (i + 1 == segments) ? length - 1 : (i + 1) * span - 1;
+        segment.curl = curl_easy_init();
+
+        if(!segment.curl) {
+            response->errorMessage = "Failed to initialize curl";
+            break;
+        }
+
+        quoneq_http_client::prepare_segment(&segment, request);
+        curl_multi_add_handle(multi, segment.curl);
+        remaining++;
+    }
+
+    std::vector<download_segment*> waiting;
+    while(remaining > 0 && response->errorMessage.empty()) {
+        auto now = std::chrono::steady_clock::now();
+
+        for(auto it = waiting.begin(); it != waiting.end();) {
+            if((*it)->retryAt > now) {
+                ++it;
+                continue;
+            }
+
+            quoneq_http_client::prepare_segment(*it, request);
+            curl_multi_add_handle(multi, (*it)->curl);
+            it = waiting.erase(it);
+        }
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+
+        CURLMsg* message = nullptr;
+        int queued = 0;
+
+        while((message = curl_multi_info_read(multi, &queued))) {
+            if(message->msg != CURLMSG_DONE)
+                continue;
+
+            void* segment_ptr = nullptr;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &segment_ptr);
+
+            download_segment* segment = static_cast<download_segment*>(segment_ptr);
+            CURLcode result = message->data.result;
+            curl_multi_remove_handle(multi, segment->curl);
+
+            if(segment->offset > segment->last) {
+                remaining--;
+                continue;
+            }
+
+            // Retry from the first byte that has not been written yet, once
+            // the policy's backoff has passed. The other ranges keep going.
+            if(segment->attempts <= max_retries) {
+                long delay_ms = quoneq_http_client::backoff_delay(
+                    request.policy,
+                    static_cast<unsigned>(segment->attempts - 1)
+                );
+
+                segment->retryAt = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(delay_ms);
+                waiting.push_back(segment);
+                quoneq_http_client::counters.retries++;
+
+                continue;
+            }
+
+            response->errorMessage = "Failed to fetch range " +
+                std::to_string(segment->offset) + "-" +
+                std::to_string(segment->last) + ": " +
+                (result != CURLE_OK
+                    ? curl_easy_strerror(result)
+                    : "incomplete response");
+        }
+
+        if(running > 0 || !waiting.empty()) {
+            auto next_retry = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+            for(download_segment* segment : waiting)
+                next_retry = std::min(next_retry, segment->retryAt);
+
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+                next_retry - std::chrono::steady_clock::now()
+            );
+
+            curl_multi_poll(
+                multi,
+                nullptr,
+                0,
+                static_cast<int>(std::clamp<std::int64_t>(wait.count(), 0, 1000)),
+                nullptr
+            );
+        }
+    }
+
+    for(download_segment& segment : parts) {
+        if(!segment.curl)
+            continue;
+
+        curl_multi_remove_handle(multi, segment.curl);
+        quoneq_net::cleanup_handle(segment.curl);
+        curl_slist_free_all(segment.header_list);
+        curl_mime_free(segment.mime);
+    }
+
+    curl_multi_cleanup(multi);
+    close(fd);
+
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::perform_download_resumable(
+    CURL* curl,
+    const quoneq_http_request& request,
+    const std::string& out_filename
+) {
+    auto response = std::make_unique<quoneq_http_response>();
+
+    resume_download download;
+    download.checkpoint_path = out_filename + ".resume";
+    download.response = response.get();
+    download.fd = open(out_filename.c_str(), O_WRONLY | O_CREAT, 0644);
+
+    if(download.fd < 0) {
+        response->errorMessage = "Unable to open output file";
+        return response;
+    }
+
+    download_checkpoint saved;
+    struct stat info;
+    std::string validator;
+
+    if(quoneq_http_client::load_checkpoint(download.checkpoint_path, &saved) &&
+        saved.url == request.url &&
+        fstat(download.fd, &info) == 0 &&
+        static_cast<size_t>(info.st_size) >= saved.offset) {
+        // Weak ETags cannot be used with If-Range.
+        if(!saved.etag.empty() && saved.etag.rfind("W/", 0) != 0)
+            validator = saved.etag;
+        else validator = saved.lastModified;
+    }
+
+    if(!validator.empty()) {
+        download.checkpoint = saved;
+        download.offset = download.synced = saved.offset;
+    }
+    download.checkpoint.url = request.url;
+
+    // Anything past the checkpoint may not have reached the disk intact.
+    if(ftruncate(download.fd, static_cast<off_t>(download.offset)) != 0) {
+        response->errorMessage = "Unable to truncate output file";
+        close(download.fd);
+
+        return response;
+    }
+
+    quoneq_http_request ranged = request;
+    if(download.offset > 0)
+        ranged.headers["If-Range"] = validator;
+
+    struct curl_slist* header_list = nullptr;
+    curl_mime* mime = nullptr;
+
+    quoneq_http_client::prepare_request(
+        curl,
+        ranged,
+        response.get(),
+        &header_list,
+        &mime
+    );
+
+    std::string range = std::to_string(download.offset) + "-";
+    if(download.offset > 0)
+        curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::resume_write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &download);
+
+    CURLcode res = curl_easy_perform(curl);
+    bool complete = false;
+
+    if(res == CURLE_OK && download.error.empty()) {
+        size_t first = 0, length = 0;
+
+        if(response->status == 416) {
+            // A previous run received everything but exited before
+            // removing its checkpoint.
+            if(download.offset > 0 &&
+                parse_content_range(response->header.get("Content-Range"), &first, &length) &&
+                length == download.offset) {
+                response->status = 200;
+                response->contentLength = length;
+                complete = true;
+            }
+            else std::remove(download.checkpoint_path.c_str());
+        }
+        else if(response->status == 200 && !download.started) {
+            // An empty body never reaches the write callback.
+            if(ftruncate(download.fd, 0) == 0)
+                complete = true;
+            else download.error = "Unable to truncate output file";
+        }
+        else if((response->status == 200 || response->status == 206) &&
+            (download.checkpoint.length == 0 ||
+                download.offset == download.checkpoint.length))
+            complete = true;
+    }
+
+    if(complete)
+        std::remove(download.checkpoint_path.c_str());
+    else if(download.started && !download.discard &&
+        fdatasync(download.fd) == 0) {
+        download.checkpoint.offset = download.offset;
+        quoneq_http_client::save_checkpoint(
+            download.checkpoint_path,
+            download.checkpoint
+        );
+    }
+
+    if(!download.error.empty())
+        response->errorMessage = download.error;
+    else if(res != CURLE_OK)
+        response->errorMessage = curl_easy_strerror(res);
+    else if(!complete && (response->status == 200 || response->status == 206))
+        response->errorMessage = "Incomplete response";
+
+    curl_slist_free_all(header_list);
+    curl_mime_free(mime);
+    close(download.fd);
+
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::get(
+    const std::string& url,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed,
+    const quoneq_http_policy& policy
+) {
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
+    request.policy = policy;
+
+    if(!quoneq_http_client::coalescing)
+        return quoneq_http_client::fetch(request);
+
+    auto shared = quoneq_http_client::fetch_coalesced(request);
+    if(!shared)
+        return nullptr;
+
+    return std::make_unique<quoneq_http_response>(*shared);
+}
+
+std::shared_ptr<const quoneq_http_response> quoneq_http_client::get_shared(
+    const std::string& url,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed,
+    const quoneq_http_policy& policy
+) {
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
+    request.policy = policy;
+
+    return quoneq_http_client::fetch_coalesced(request);
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::fetch(
+    const quoneq_http_request& request
+) {
+    std::shared_ptr<quoneq_http_cache> cache = quoneq_http_client::get_cache();
+    quoneq_http_request conditional = request;
+
+    if(cache) {
+        auto cached = cache->lookup(request, &conditional);
+        if(cached)
+            return cached;
+    }
+
+    CURL* curl = curl_easy_init();
+    if(!curl)
+        return nullptr;
 
-    if(header_line.find("HTTP/") == 0) {
-        std::istringstream iss(header_line);
-        std::string protocol, status_code, status_text;
-        iss >> protocol >> status_code >> status_text;
+    auto response = quoneq_http_client::perform(curl, conditional);
+    if(cache) {
+        response = cache->update(request, std::move(response));
 
-        response->statusType = status_text;
-        response->status = static_cast<uint16_t>(
-            std::stoi(status_code)
-        );
-    }
+        // A 304 to validators the cache added, for an entry evicted in the
+        // meantime, has no body to give the caller.
+        if(response && response->status == 304 &&
+            conditional.headers != request.headers) {
+            curl_easy_reset(curl);
 
-    size_t delimiter_pos = header_line.find(": ");
-    if(delimiter_pos != std::string::npos) {
-        std::string key = header_line.substr(0, delimiter_pos);
-        std::string value = header_line.substr(delimiter_pos + 2);
-
-        if(!value.empty() && value.back() == '\n')
-            value.pop_back();
-        if(!value.empty() && value.back() == '\r')
-            value.pop_back();
-        
-        if(key == "Set-Cookie") {
-            size_t semicolon_pos = value.find(';');
-            std::string cookie_name = value.substr(0, value.find('='));
-            std::string cookie_value = value.substr(
-                value.find('=') + 1,
-                semicolon_pos - value.find('=') - 1
-            );
-            response->cookies[cookie_name] = cookie_value;
+            response = quoneq_http_client::perform(curl, request);
+            response = cache->update(request, std::move(response));
         }
-        else response->header[key] = value;
     }
-    
-    return total_size;
+
+    quoneq_net::cleanup_handle(curl);
+    return response;
 }
 
-struct curl_slist* quoneq_http_client::prepare_headers(
-    const std::map<std::string, std::string>& headers
+std::shared_ptr<const quoneq_http_response> quoneq_http_client::fetch_coalesced(
+    const quoneq_http_request& request
 ) {
-    struct curl_slist* curl_headers = nullptr;
+    // Every request field that can change the response is part of the key.
+    std::string key = request.method + " " + request.url + "\n" +
+        request.proxy + "\n" +
+        request.username + ":" + request.password + "\n" +
+        (request.compressed ? "compressed\n" : "identity\n");
+
+    for(const auto& header : request.headers)
+        key += header.first + ": " + header.second + "\n";
+
+    for(const auto& cookie : request.cookies)
+        key += cookie.first + "=" + cookie.second + ";";
+
+    // Callers with different timeouts or retries must not wait on each other.
+    const quoneq_http_policy& policy = request.policy;
+    key += "\n" + std::to_string(policy.connectTimeoutMs) + "," +
+        std::to_string(policy.timeoutMs) + "," +
+        std::to_string(policy.lowSpeedLimit) + "," +
+        std::to_string(policy.lowSpeedTime) + "," +
+        std::to_string(policy.maxRetries) + "," +
+        std::to_string(policy.backoffBaseMs) + "," +
+        std::to_string(policy.backoffMaxMs) + "," +
+        (policy.retryNonIdempotent ? "1" : "0");
+
+    for(uint16_t status : policy.retryStatuses)
+        key += "," + std::to_string(status);
+
+    std::promise<std::shared_ptr<const quoneq_http_response>> promise;
+    flight pending;
+    bool leader = false;
+
+    {
+        std::lock_guard<std::mutex> lock(quoneq_http_client::flight_lock);
+
+        auto found = quoneq_http_client::flights.find(key);
+        if(found != quoneq_http_client::flights.end())
+            pending = found->second;
+        else {
+            pending = promise.get_future().share();
+            quoneq_http_client::flights.emplace(key, pending);
+            leader = true;
+        }
+    }
 
-    for(const auto& header : headers) {
-        std::string header_str = header.first + ": " + header.second;
-        curl_headers = curl_slist_append(
-            curl_headers,
-            header_str.c_str()
-        );
+    if(!leader)
+        return pending.get();
+
+    // The flight is retired before it completes, so that a request made
+    // after the response is published starts a transfer of its own. The
+    // guard also retires it when the transfer throws, so that the key is
+    // not left pointing at a future that will never be fulfilled.
+    struct flight_guard {
+        const std::string& key;
+        bool landed = false;
+
+        void land() {
+            if(this->landed)
+                return;
+
+            std::lock_guard<std::mutex> lock(quoneq_http_client::flight_lock);
+            quoneq_http_client::flights.erase(this->key);
+            this->landed = true;
+        }
+
+        ~flight_guard() {
+            this->land();
+        }
+    } guard{key};
+
+    std::shared_ptr<const quoneq_http_response> response;
+    try {
+        response = quoneq_http_client::fetch(request);
     }
-    return curl_headers;
+    catch(...) {
+        guard.land();
+        promise.set_exception(std::current_exception());
+
+        throw;
+    }
+
+    guard.land();
+    promise.set_value(response);
+
+    return response;
 }
 
-std::string quoneq_http_client::prepare_cookies(
-    const std::map<std::string, std::string>& cookies
-) {
-    std::string cookie_str;
+void quoneq_http_client::set_coalescing(bool enabled) {
+    quoneq_http_client::coalescing = enabled;
+}
 
-    for(const auto& cookie : cookies) {
-        if(!cookie_str.empty())
-            cookie_str += "; ";
-        cookie_str += cookie.first + "=" + cookie.second;
-    }
-    return cookie_str;
+void quoneq_http_client::set_cache(std::shared_ptr<quoneq_http_cache> cache) {
+    std::lock_guard<std::mutex> lock(quoneq_http_client::cache_lock);
+    quoneq_http_client::response_cache = std::move(cache);
 }
 
-std::unique_ptr<quoneq_http_response> quoneq_http_client::get(
+std::shared_ptr<quoneq_http_cache> quoneq_http_client::get_cache() {
+    std::lock_guard<std::mutex> lock(quoneq_http_client::cache_lock);
+    return quoneq_http_client::response_cache;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_client::post(
     const std::string& url,
+    const std::map<std::string, std::string>& form,
     const std::map<std::string, std::string>& headers,
     const std::map<std::string, std::string>& cookies,
+    const std::map<std::string, std::string>& files,
     const std::string& proxy,
     const std::string& username,
-    const std::string& password
+    const std::string& password,
+    bool compressed,
+    const quoneq_http_policy& policy
 ) {
     CURL* curl = curl_easy_init();
     if(!curl)
         return nullptr;
 
-    auto response = std::make_unique<quoneq_http_response>();
-    std::string response_string;
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_string);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, quoneq_http_client::header_callback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, response.get());
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
-    );
-
-    struct curl_slist* curl_headers = quoneq_http_client::prepare_headers(headers);
-    if(curl_headers)
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, curl_headers);
+    quoneq_http_request request;
+    request.method = "POST";
+    request.url = url;
+    request.form = form;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.files = files;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
+    request.policy = policy;
+
+    auto response = quoneq_http_client::perform(curl, request);
+    quoneq_net::cleanup_handle(curl);
 
-    std::string cookie_str = quoneq_http_client::prepare_cookies(cookies);
-    if(!cookie_str.empty())
-        curl_easy_setopt(curl, CURLOPT_COOKIE, cookie_str.c_str());
+    return response;
+}
 
-    if(!proxy.empty())
-        curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
+std::unique_ptr<quoneq_http_response> quoneq_http_client::post_body(
+    const std::string& url,
+    const quoneq_http_body& body,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl)
+        return nullptr;
 
-    if(!username.empty() && !password.empty()) {
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
-        curl_easy_setopt(
-            curl,
-            CURLOPT_USERPWD,
-            (username + ":" + password).c_str()
-        );
-    }
+    quoneq_http_request request;
+    request.method = "POST";
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
 
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK) {
-        response->errorMessage = curl_easy_strerror(res);
+    auto response = quoneq_http_client::perform_body(curl, request, body);
+    quoneq_net::cleanup_handle(curl);
 
-        curl_slist_free_all(curl_headers);
-        curl_easy_cleanup(curl);
+    return response;
+}
 
-        return response;
-    }
+std::unique_ptr<quoneq_http_response> quoneq_http_client::get_stream(
+    const std::string& url,
+    const quoneq_http_sink& sink,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl)
+        return nullptr;
 
-    response->content = response_string;
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
 
-    curl_slist_free_all(curl_headers);
-    curl_easy_cleanup(curl);
+    auto response = quoneq_http_client::perform_stream(curl, request, sink);
+    quoneq_net::cleanup_handle(curl);
 
     return response;
 }
 
-std::unique_ptr<quoneq_http_response> quoneq_http_client::post(
+std::unique_ptr<quoneq_http_response> quoneq_http_client::post_stream(
     const std::string& url,
+    const quoneq_http_sink& sink,
     const std::map<std::string, std::string>& form,
     const std::map<std::string, std::string>& headers,
     const std::map<std::string, std::string>& cookies,
     const std::map<std::string, std::string>& files,
     const std::string& proxy,
     const std::string& username,
-    const std::string& password
+    const std::string& password,
+    bool compressed
 ) {
     CURL* curl = curl_easy_init();
     if(!curl)
         return nullptr;
 
-    auto response = std::make_unique<quoneq_http_response>();
-    std::string response_string;
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_string);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, quoneq_http_client::header_callback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, response.get());
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
-    );
-
-    curl_mime* mime = curl_mime_init(curl);
-    for(const auto& field : form) {
-        curl_mimepart* part = curl_mime_addpart(mime);
-        curl_mime_name(part, field.first.c_str());
-        curl_mime_data(part, field.second.c_str(), CURL_ZERO_TERMINATED);
-    }
+    quoneq_http_request request;
+    request.method = "POST";
+    request.url = url;
+    request.form = form;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.files = files;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
+
+    auto response = quoneq_http_client::perform_stream(curl, request, sink);
+    quoneq_net::cleanup_handle(curl);
 
-    for(const auto& file : files) {
-        curl_mimepart* part = curl_mime_addpart(mime);
-        curl_mime_name(part, file.first.c_str());
-        curl_mime_filedata(part, file.second.c_str());
-
-        std::string filename = file.second.substr(
-            file.second.find_last_of("/\\") + 1
-        );
-        curl_mime_filename(part, filename.c_str());
-    }
-    curl_easy_setopt(curl, CURLOPT_MIMEPOST, mime);
-
-    struct curl_slist* curl_headers = quoneq_http_client::prepare_headers(headers);
-    if(curl_headers)
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, curl_headers);
-
-    std::string cookie_str = quoneq_http_client::prepare_cookies(cookies);
-    if(!cookie_str.empty())
-        curl_easy_setopt(curl, CURLOPT_COOKIE, cookie_str.c_str());
+    return response;
+}
 
-    if(!proxy.empty())
-        curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
+std::future<std::unique_ptr<quoneq_http_response>> quoneq_http_client::request_async(
+    const quoneq_http_request& request
+) {
+    auto task = std::make_shared<async_request>();
+    auto future = task->promise.get_future();
 
-    if(!username.empty() && !password.empty()) {
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
-        curl_easy_setopt(
-            curl,
-            CURLOPT_USERPWD,
-            (username + ":" + password).c_str()
-        );
+    task->curl = curl_easy_init();
+    if(!task->curl) {
+        task->promise.set_value(nullptr);
+        return future;
     }
 
-    CURLcode res = curl_easy_perform(curl);
-    if(res != CURLE_OK) {
-        response->errorMessage = curl_easy_strerror(res);
+    task->response = std::make_unique<quoneq_http_response>();
+    quoneq_http_client::prepare_request(
+        task->curl,
+        request,
+        task->response.get(),
+        &task->header_list,
+        &task->mime
+    );
+    curl_easy_setopt(task->curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
+    curl_easy_setopt(task->curl, CURLOPT_WRITEDATA, task->response.get());
+
+    quoneq_event_loop::submit(task->curl, [task](CURLcode result) {
+        quoneq_http_client::read_transfer_info(task->curl, task->response.get());
+        if(result != CURLE_OK) {
+            task->response->errorMessage = curl_easy_strerror(result);
+            task->response->content.clear();
+        }
 
-        curl_slist_free_all(curl_headers);
-        curl_mime_free(mime);
-        curl_easy_cleanup(curl);
+        curl_slist_free_all(task->header_list);
+        curl_mime_free(task->mime);
+        quoneq_net::cleanup_handle(task->curl);
 
-        return response;
-    }
+        task->promise.set_value(std::move(task->response));
+    });
 
-    response->content = response_string;
+    return future;
+}
 
-    curl_slist_free_all(curl_headers);
-    curl_mime_free(mime);
-    curl_easy_cleanup(curl);
+std::future<std::unique_ptr<quoneq_http_response>> quoneq_http_client::get_async(
+    const std::string& url,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed
+) {
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
+
+    return quoneq_http_client::request_async(request);
+}
 
-    return response;
+std::future<std::unique_ptr<quoneq_http_response>> quoneq_http_client::post_async(
+    const std::string& url,
+    const std::map<std::string, std::string>& form,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::map<std::string, std::string>& files,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed
+) {
+    quoneq_http_request request;
+    request.method = "POST";
+    request.url = url;
+    request.form = form;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.files = files;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.compressed = compressed;
+
+    return quoneq_http_client::request_async(request);
 }
 
 std::unique_ptr<quoneq_http_response> quoneq_http_client::ping(
@@ -291,55 +2055,16 @@ std::unique_ptr<quoneq_http_response> quoneq_http_client::ping(
     if(!curl)
         return nullptr;
 
-    auto response = std::make_unique<quoneq_http_response>();
-    std::string response_string;
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_string);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, quoneq_http_client::header_callback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, response.get());
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 5L);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
-    );
-
-    if(!proxy.empty())
-        curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
-
-    if(!username.empty() && !password.empty()) {
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
-        curl_easy_setopt(
-            curl,
-            CURLOPT_USERPWD,
-            (username + ":" + password).c_str()
-        );
-    }
-
-    auto start = std::chrono::high_resolution_clock::now();
-    CURLcode res = curl_easy_perform(curl);
-    auto end = std::chrono::high_resolution_clock::now();
-
-    if(res == CURLE_OK) {
-        long response_code;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-        response->status = static_cast<uint16_t>(response_code);
+    quoneq_http_request request;
+    request.method = "HEAD";
+    request.url = url;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
 
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-        response->content = std::to_string(duration.count()) + " ms";
-    }
-    else {
-        response->status = 0;
-        response->content = curl_easy_strerror(res);
-    }
+    auto response = quoneq_http_client::perform_ping(curl, request);
+    quoneq_net::cleanup_handle(curl);
 
-    curl_easy_cleanup(curl);
     return response;
 }
 
@@ -352,92 +2077,98 @@ std::unique_ptr<quoneq_http_response> quoneq_http_client::download_file(
     const std::map<std::string, std::string>& files,
     const std::string& proxy,
     const std::string& username,
-    const std::string& password
+    const std::string& password,
+    const quoneq_file_sink_options& sink_options,
+    const quoneq_http_policy& policy
 ) {
     CURL* curl = curl_easy_init();
     if(!curl)
         return nullptr;
 
-    auto response = std::make_unique<quoneq_http_response>();
-    std::ofstream output_file(out_filename, std::ios::binary);
-
-    if(!output_file) {
-        curl_easy_cleanup(curl);
-        response->errorMessage = "Unable to open output file";
-        return response;
-    }
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_file_callback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &output_file);
-    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, quoneq_http_client::header_callback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, response.get());
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(
+    quoneq_http_request request;
+    request.url = url;
+    request.form = form;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.files = files;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.policy = policy;
+
+    auto response = quoneq_http_client::perform_download_file(
         curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
+        request,
+        out_filename,
+        sink_options
     );
+    quoneq_net::cleanup_handle(curl);
 
-    struct curl_slist* header_list = quoneq_http_client::prepare_headers(headers);
-    if(header_list)
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
-
-    std::string cookie_str = quoneq_http_client::prepare_cookies(cookies);
-    if(!cookie_str.empty())
-        curl_easy_setopt(curl, CURLOPT_COOKIE, cookie_str.c_str());
-
-    curl_mime* mime = nullptr;
-    if(!form.empty() || !files.empty()) {
-        mime = curl_mime_init(curl);
-        for(const auto& field : form) {
-            curl_mimepart* part = curl_mime_addpart(mime);
-            curl_mime_name(part, field.first.c_str());
-            curl_mime_data(part, field.second.c_str(), CURL_ZERO_TERMINATED);
-        }
-
-        for(const auto& file : files) {
-            curl_mimepart* part = curl_mime_addpart(mime);
-            curl_mime_name(part, file.first.c_str());
-            curl_mime_filedata(part, file.second.c_str());
-
-            std::string filename = file.second.substr(
-                file.second.find_last_of("/\\") + 1
-            );
-            curl_mime_filename(part, filename.c_str());
-        }
-
-        curl_easy_setopt(curl, CURLOPT_MIMEPOST, mime);
-    }
+    return response;
+}
 
-    if(!proxy.empty())
-        curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
+std::unique_ptr<quoneq_http_response> quoneq_http_client::download_file_segmented(
+    const std::string& url,
+    const std::string& out_filename,
+    size_t segments,
+    size_t max_retries,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl)
+        return nullptr;
 
-    if(!username.empty() && !password.empty()) {
-        curl_easy_setopt(curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
-        curl_easy_setopt(
-            curl,
-            CURLOPT_USERPWD,
-            (username + ":" + password).c_str()
-        );
-    }
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
 
-    CURLcode res = curl_easy_perform(curl);
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    response->status = static_cast<uint16_t>(http_code);
+    auto response = quoneq_http_client::perform_download_segmented(
+        curl,
+        request,
+        out_filename,
+        segments,
+        max_retries
+    );
+    quoneq_net::cleanup_handle(curl);
 
-    if(res != CURLE_OK)
-        response->errorMessage = curl_easy_strerror(res);
+    return response;
+}
 
-    if(header_list)
-        curl_slist_free_all(header_list);
+std::unique_ptr<quoneq_http_response> quoneq_http_client::download_file_resumable(
+    const std::string& url,
+    const std::string& out_filename,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl)
+        return nullptr;
 
-    if(mime)
-        curl_mime_free(mime);
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
 
-    curl_easy_cleanup(curl);
-    output_file.close();
+    auto response = quoneq_http_client::perform_download_resumable(
+        curl,
+        request,
+        out_filename
+    );
+    quoneq_net::cleanup_handle(curl);
 
     return response;
 }
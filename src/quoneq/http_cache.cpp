@@ -0,0 +1,568 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/http_cache.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string_view>
+
+/**
+ * @brief Compares two header field names case-insensitively.
+ */
+static inline bool same_name(std::string_view left, std::string_view right) {
+    quoneq_http_header_less less;
+    return !less(left, right) && !less(right, left);
+}
+
+/**
+ * @brief Strips leading and trailing whitespace.
+ */
+static std::string_view strip(std::string_view value) {
+    while(!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+        value.remove_prefix(1);
+
+    while(!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+        value.remove_suffix(1);
+
+    return value;
+}
+
+/**
+ * @brief Calls a function with every element of a comma-separated list.
+ */
+static void for_each_token(
+    std::string_view list,
+    const std::function<void(std::string_view)>& function
+) {
+    while(!list.empty()) {
+        size_t comma = list.find(',');
+        std::string_view token = strip(list.substr(0, comma));
+
+        if(!token.empty())
+            function(token);
+
+        if(comma == std::string_view::npos)
+            break;
+        list.remove_prefix(comma + 1);
+    }
+}
+
+/**
+ * @brief Looks up a directive in the Cache-Control fields of a header table.
+ *
+ * @param header The header table.
+ * @param name The directive name.
+ * @param value Receives the numeric argument of the directive, if any.
+ * @return True if the directive is present; false otherwise.
+ */
+static bool cache_directive(
+    const quoneq_http_headers& header,
+    std::string_view name,
+    long* value = nullptr
+) {
+    bool found = false;
+
+    for(std::string_view field : header.get_all("Cache-Control"))
+        for_each_token(field, [&](std::string_view token) {
+            size_t equals = token.find('=');
+            if(found || !same_name(strip(token.substr(0, equals)), name))
+                return;
+
+            found = true;
+            if(value && equals != std::string_view::npos) {
+                std::string_view argument = strip(token.substr(equals + 1));
+                if(argument.size() >= 2 && argument.front() == '"' && argument.back() == '"')
+                    argument = argument.substr(1, argument.size() - 2);
+
+                std::from_chars(argument.data(), argument.data() + argument.size(), *value);
+            }
+        });
+
+    return found;
+}
+
+/**
+ * @brief Parses an HTTP date.
+ *
+ * @return The time, or -1 if the date is absent or malformed.
+ */
+static std::time_t parse_date(std::string_view date) {
+    if(date.empty())
+        return -1;
+
+    return curl_getdate(std::string(date).c_str(), nullptr);
+}
+
+/**
+ * @brief Returns the value of a request header, matched case-insensitively.
+ */
+static std::string_view request_header(
+    const quoneq_http_request& request,
+    std::string_view name
+) {
+    for(const auto& header : request.headers)
+        if(same_name(header.first, name))
+            return header.second;
+
+    return {};
+}
+
+/**
+ * @brief Estimates the memory held by a cached response.
+ */
+static size_t entry_size(const std::string& key, const quoneq_http_response& response) {
+    size_t size = key.size() + response.content.size() + response.statusType.size();
+
+    for(const auto& [name, value] : response.header)
+        size += name.size() + value.size();
+
+    for(const auto& [name, value] : response.cookies)
+        size += name.size() + value.size();
+
+    return size;
+}
+
+quoneq_http_cache::quoneq_http_cache(const quoneq_http_cache_options& cache_options) :
+    options(cache_options),
+    lock(),
+    entries(),
+    index(),
+    bytes(0),
+    counters() {}
+
+std::string quoneq_http_cache::make_key(const quoneq_http_request& request) {
+    if(request.method != "GET" || !request.form.empty() || !request.files.empty())
+        return "";
+
+    // Requests that are already conditional or partial are the caller's to
+    // manage, as are those asking not to be stored.
+    for(std::string_view name : {
+        "Range", "If-Range", "If-Match", "If-None-Match",
+        "If-Modified-Since", "If-Unmodified-Since"
+    })
+        if(!request_header(request, name).empty())
+            return "";
+
+    if(request_header(request, "Cache-Control").find("no-store") != std::string_view::npos)
+        return "";
+
+    std::string key = request.url;
+    key += request.compressed ? "\tcompressed\t" : "\tidentity\t";
+    key += request.username;
+    key += "\t";
+
+    // Everything that identifies the requester or the route partitions the
+    // cache too. The key is written to disk, so these only enter it hashed.
+    std::string identity;
+    for(const auto& cookie : request.cookies)
+        identity += cookie.first + "=" + cookie.second + ";";
+
+    identity += '\0';
+    identity += request.password;
+    identity += '\0';
+    identity += request.proxy;
+    identity += '\0';
+    identity += request_header(request, "Authorization");
+    identity += '\0';
+    identity += request_header(request, "Proxy-Authorization");
+
+    char digest[17];
+    std::snprintf(digest, sizeof(digest), "%016zx", std::hash<std::string>{}(identity));
+
+    key += "\t";
+    key += digest;
+
+    return key;
+}
+
+std::time_t quoneq_http_cache::freshness(
+    const quoneq_http_headers& header,
+    std::time_t now
+) {
+    if(cache_directive(header, "no-cache"))
+        return now;
+
+    std::time_t date = parse_date(header.get("Date"));
+    if(date < 0)
+        date = now;
+
+    // The cache is shared by every caller in the process, so s-maxage takes
+    // precedence over max-age.
+    long lifetime = 0;
+    if(!cache_directive(header, "s-maxage", &lifetime) &&
+        !cache_directive(header, "max-age", &lifetime)) {
+        std::string_view expires = header.get("Expires");
+
+        if(!expires.empty()) {
+            std::time_t expiry = parse_date(expires);
+            lifetime = expiry < 0 ? 0 : static_cast<long>(expiry - date);
+        }
+        else {
+            // Without explicit freshness, a response that has not changed
+            // for a long time is assumed not to change soon either.
+            std::time_t modified = parse_date(header.get("Last-Modified"));
+            if(modified >= 0 && modified < date)
+                lifetime = std::min(static_cast<long>(date - modified) / 10, 86400L);
+        }
+    }
+
+    std::string_view age_field = header.get("Age");
+    long age = 0;
+    std::from_chars(age_field.data(), age_field.data() + age_field.size(), age);
+
+    lifetime -= age;
+    return lifetime > 0 ? now + lifetime : now;
+}
+
+bool quoneq_http_cache::storable(
+    const quoneq_http_request& request,
+    const quoneq_http_response& response
+) {
+    if(!response.errorMessage.empty() || response.status != 200)
+        return false;
+
+    if(cache_directive(response.header, "no-store") ||
+        cache_directive(response.header, "private"))
+        return false;
+
+    // Responses to authenticated requests are only shared when the origin
+    // says so explicitly (RFC 9111, section 3.5).
+    bool authorized = !request.username.empty() || !request.password.empty() ||
+        !request_header(request, "Authorization").empty();
+
+    if(authorized && !cache_directive(response.header, "public") &&
+        !cache_directive(response.header, "s-maxage"))
+        return false;
+
+    return strip(response.header.get("Vary")) != "*";
+}
+
+bool quoneq_http_cache::vary_matches(
+    const entry& cached,
+    const quoneq_http_request& request
+) {
+    for(const auto& [name, value] : cached.vary)
+        if(request_header(request, name) != value)
+            return false;
+
+    return true;
+}
+
+std::string quoneq_http_cache::disk_path(const std::string& key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016zx.cache", std::hash<std::string>{}(key));
+
+    return this->options.directory + "/" + name;
+}
+
+void quoneq_http_cache::save(const entry& cached) const {
+    if(this->options.directory.empty())
+        return;
+
+    const std::string path = this->disk_path(cached.key);
+    const std::string staging = path + ".tmp";
+    {
+        std::ofstream file(staging, std::ios::binary | std::ios::trunc);
+        if(!file)
+            return;
+
+        const quoneq_http_response& response = cached.response;
+        file << "key: " << cached.key << "\n"
+            << "expires: " << cached.expires << "\n"
+            << "status: " << response.status << "\n"
+            << "status-type: " << response.statusType << "\n"
+            << "version: " << response.httpVersion << "\n"
+            << "content-length: " << response.contentLength << "\n"
+            << "wire-length: " << response.wireLength << "\n";
+
+        for(const auto& [name, value] : cached.vary)
+            file << "vary: " << name << ": " << value << "\n";
+
+        for(const auto& [name, value] : response.header)
+            file << "header: " << name << ": " << value << "\n";
+
+        file << "length: " << response.content.size() << "\n\n";
+        file.write(response.content.data(), static_cast<std::streamsize>(response.content.size()));
+
+        if(!file)
+            return;
+    }
+
+    std::rename(staging.c_str(), path.c_str());
+}
+
+bool quoneq_http_cache::load(const std::string& key, entry* cached) const {
+    if(this->options.directory.empty())
+        return false;
+
+    std::ifstream file(this->disk_path(key), std::ios::binary);
+    if(!file)
+        return false;
+
+    auto split = [](std::string_view field) {
+        size_t separator = field.find(": ");
+        if(separator == std::string_view::npos)
+            return std::make_pair(field, std::string_view());
+
+        return std::make_pair(field.substr(0, separator), field.substr(separator + 2));
+    };
+
+    quoneq_http_response& response = cached->response;
+    size_t length = 0;
+    std::string line;
+
+    while(std::getline(file, line) && !line.empty()) {
+        auto [name, value] = split(line);
+        const char* first = value.data();
+        const char* last = value.data() + value.size();
+
+        if(name == "key")
+            cached->key = value;
+        else if(name == "expires")
+            std::from_chars(first, last, cached->expires);
+        else if(name == "status")
+            std::from_chars(first, last, response.status);
+        else if(name == "status-type")
+            response.statusType = value;
+        else if(name == "version")
+            response.httpVersion = value;
+        else if(name == "content-length")
+            std::from_chars(first, last, response.contentLength);
+        else if(name == "wire-length")
+            std::from_chars(first, last, response.wireLength);
+        else if(name == "vary") {
+            auto field = split(value);
+            cached->vary.emplace_back(field.first, field.second);
+        }
+        else if(name == "header") {
+            auto field = split(value);
+            response.header.add(field.first, field.second);
+        }
+        else if(name == "length")
+            std::from_chars(first, last, length);
+    }
+
+    // The file name is a hash of the key, so the key itself is checked too.
+    if(cached->key != key)
+        return false;
+
+    response.content.resize(length);
+    file.read(response.content.data(), static_cast<std::streamsize>(length));
+    response.decodedLength = length;
+
+    return static_cast<size_t>(file.gcount()) == length;
+}
+
+std::list<quoneq_http_cache::entry>::iterator quoneq_http_cache::find(const std::string& key) {
+    auto found = this->index.find(key);
+    if(found != this->index.end()) {
+        this->entries.splice(this->entries.begin(), this->entries, found->second);
+        return found->second;
+    }
+
+    entry cached;
+    if(!this->load(key, &cached))
+        return this->entries.end();
+
+    this->insert(std::move(cached));
+    return this->entries.begin();
+}
+
+void quoneq_http_cache::insert(entry cached) {
+    auto found = this->index.find(cached.key);
+    if(found != this->index.end()) {
+        this->bytes -= found->second->bytes;
+        this->entries.erase(found->second);
+        this->index.erase(found);
+    }
+
+    cached.bytes = entry_size(cached.key, cached.response);
+    this->bytes += cached.bytes;
+
+    this->entries.push_front(std::move(cached));
+    this->index[this->entries.front().key] = this->entries.begin();
+
+    // The newest entry always fits, since oversized responses are never stored.
+    while(this->bytes > this->options.maxBytes && this->entries.size() > 1) {
+        entry& oldest = this->entries.back();
+
+        this->bytes -= oldest.bytes;
+        this->index.erase(oldest.key);
+        this->entries.pop_back();
+        this->counters.evictions++;
+    }
+}
+
+void quoneq_http_cache::erase(const std::string& key) {
+    auto found = this->index.find(key);
+    if(found != this->index.end()) {
+        this->bytes -= found->second->bytes;
+        this->entries.erase(found->second);
+        this->index.erase(found);
+    }
+
+    if(!this->options.directory.empty())
+        std::remove(this->disk_path(key).c_str());
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_cache::lookup(
+    const quoneq_http_request& request,
+    quoneq_http_request* conditional
+) {
+    std::string key = quoneq_http_cache::make_key(request);
+    if(key.empty())
+        return nullptr;
+
+    std::lock_guard<std::mutex> guard(this->lock);
+
+    auto cached = this->find(key);
+    if(cached == this->entries.end() || !quoneq_http_cache::vary_matches(*cached, request))
+        return nullptr;
+
+    bool forced = request_header(request, "Cache-Control").find("no-cache") != std::string_view::npos;
+    if(!forced && cached->expires > std::time(nullptr)) {
+        this->counters.hits++;
+        return std::make_unique<quoneq_http_response>(cached->response);
+    }
+
+    std::string_view etag = cached->response.header.get("ETag");
+    if(!etag.empty())
+        conditional->headers["If-None-Match"] = std::string(etag);
+
+    std::string_view modified = cached->response.header.get("Last-Modified");
+    if(!modified.empty())
+        conditional->headers["If-Modified-Since"] = std::string(modified);
+
+    return nullptr;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_cache::update(
+    const quoneq_http_request& request,
+    std::unique_ptr<quoneq_http_response> response
+) {
+    std::string key = quoneq_http_cache::make_key(request);
+    if(key.empty() || !response)
+        return response;
+
+    std::time_t now = std::time(nullptr);
+    std::lock_guard<std::mutex> guard(this->lock);
+
+    if(response->status == 304 && response->errorMessage.empty()) {
+        auto cached = this->find(key);
+
+        if(cached != this->entries.end() && quoneq_http_cache::vary_matches(*cached, request)) {
+            // Fields sent with the 304 replace the stored ones of the same name.
+            quoneq_http_headers merged;
+            for(const auto& [name, value] : cached->response.header)
+                if(!response->header.contains(name))
+                    merged.add(name, value);
+
+            for(const auto& [name, value] : response->header)
+                merged.add(name, value);
+
+            cached->response.header = std::move(merged);
+            cached->expires = quoneq_http_cache::freshness(cached->response.header, now);
+
+            this->bytes -= cached->bytes;
+            cached->bytes = entry_size(cached->key, cached->response);
+            this->bytes += cached->bytes;
+
+            this->save(*cached);
+            this->counters.revalidations++;
+
+            // Cookies are never stored, but those set by the 304 itself
+            // still belong to this caller.
+            auto refreshed = std::make_unique<quoneq_http_response>(cached->response);
+            refreshed->cookies = std::move(response->cookies);
+
+            return refreshed;
+        }
+
+        // The entry was evicted after lookup(); the caller has to repeat the
+        // request without validators.
+        return response;
+    }
+
+    this->counters.misses++;
+    if(!quoneq_http_cache::storable(request, *response)) {
+        if(response->errorMessage.empty() && response->status == 200)
+            this->erase(key);
+
+        return response;
+    }
+
+    entry cached;
+    cached.key = key;
+    cached.expires = quoneq_http_cache::freshness(response->header, now);
+
+    bool validated = response->header.contains("ETag") ||
+        response->header.contains("Last-Modified");
+
+    if((cached.expires <= now && !validated) ||
+        entry_size(key, *response) > this->options.maxBytes) {
+        this->erase(key);
+        return response;
+    }
+
+    for(std::string_view field : response->header.get_all("Vary"))
+        for_each_token(field, [&](std::string_view name) {
+            cached.vary.emplace_back(name, request_header(request, name));
+        });
+
+    // Cookies are session credentials of whoever made the request, so they
+    // are neither persisted nor replayed to later callers.
+    cached.response = *response;
+    cached.response.cookies.clear();
+    this->save(cached);
+    this->insert(std::move(cached));
+
+    return response;
+}
+
+void quoneq_http_cache::clear() {
+    std::lock_guard<std::mutex> guard(this->lock);
+
+    // Entries evicted from memory may still be on disk, so the directory
+    // is swept rather than the index.
+    if(!this->options.directory.empty()) {
+        std::error_code error;
+
+        for(const auto& file : std::filesystem::directory_iterator(this->options.directory, error))
+            if(file.path().extension() == ".cache")
+                std::filesystem::remove(file.path(), error);
+    }
+
+    this->entries.clear();
+    this->index.clear();
+    this->bytes = 0;
+}
+
+quoneq_http_cache_stats quoneq_http_cache::stats() const {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->counters;
+}
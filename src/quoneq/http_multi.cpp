@@ -0,0 +1,188 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/http_multi.hpp>
+#include <quoneq/net.hpp>
+
+quoneq_http_multi::quoneq_http_multi(
+    size_t max_in_flight,
+    long max_per_host,
+    bool http2,
+    long max_streams
+) :
+    multi(curl_multi_init()),
+    in_flight_limit(max_in_flight == 0 ? 1 : max_in_flight),
+    multiplex(http2),
+    idle() {
+    if(!this->multi)
+        return;
+
+    curl_multi_setopt(
+        this->multi,
+        CURLMOPT_MAX_TOTAL_CONNECTIONS,
+        static_cast<long>(this->in_flight_limit)
+    );
+    curl_multi_setopt(this->multi, CURLMOPT_MAX_HOST_CONNECTIONS, max_per_host);
+
+    if(this->multiplex) {
+        curl_multi_setopt(this->multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(
+            this->multi,
+            CURLMOPT_MAX_CONCURRENT_STREAMS,
+            max_streams > 0 ? max_streams : 1L
+        );
+    }
+    else curl_multi_setopt(this->multi, CURLMOPT_PIPELINING, CURLPIPE_NOTHING);
+}
+
+quoneq_http_multi::~quoneq_http_multi() {
+    for(CURL* curl : this->idle)
+        quoneq_net::cleanup_handle(curl);
+
+    if(this->multi)
+        curl_multi_cleanup(this->multi);
+}
+
+std::unique_ptr<quoneq_http_multi::transfer> quoneq_http_multi::start(
+    const quoneq_http_request& request,
+    size_t index
+) {
+    auto task = std::make_unique<transfer>();
+    task->index = index;
+    task->policy = &request.policy;
+    task->response = std::make_unique<quoneq_http_response>();
+
+    if(!this->idle.empty()) {
+        task->curl = this->idle.back();
+        this->idle.pop_back();
+
+        curl_easy_reset(task->curl);
+    }
+    else {
+        task->curl = curl_easy_init();
+        quoneq_net::persist_handle(task->curl);
+    }
+
+    if(!task->curl) {
+        task->response->errorMessage = "Failed to initialize curl";
+        return task;
+    }
+
+    quoneq_http_client::prepare_request(
+        task->curl,
+        request,
+        task->response.get(),
+        &task->header_list,
+        &task->mime
+    );
+    curl_easy_setopt(task->curl, CURLOPT_WRITEFUNCTION, quoneq_http_client::write_callback);
+    curl_easy_setopt(task->curl, CURLOPT_WRITEDATA, task->response.get());
+    curl_easy_setopt(task->curl, CURLOPT_PRIVATE, task.get());
+
+    // Waiting for a pending connection lets concurrent requests to the same
+    // origin become streams of it instead of opening connections of their own.
+    if(this->multiplex) {
+        curl_easy_setopt(task->curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(task->curl, CURLOPT_PIPEWAIT, 1L);
+    }
+    else curl_easy_setopt(task->curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+
+    curl_multi_add_handle(this->multi, task->curl);
+    return task;
+}
+
+void quoneq_http_multi::finish(transfer* task, CURLcode result) {
+    quoneq_http_client::read_transfer_info(task->curl, task->response.get());
+    quoneq_http_client::record_timeout(task->curl, result, *task->policy);
+    if(result != CURLE_OK) {
+        task->response->errorMessage = curl_easy_strerror(result);
+        task->response->content.clear();
+    }
+
+    curl_multi_remove_handle(this->multi, task->curl);
+    curl_slist_free_all(task->header_list);
+    curl_mime_free(task->mime);
+
+    this->idle.push_back(task->curl);
+    task->curl = nullptr;
+}
+
+std::vector<std::unique_ptr<quoneq_http_response>> quoneq_http_multi::perform(
+    const std::vector<quoneq_http_request>& requests
+) {
+    std::vector<std::unique_ptr<quoneq_http_response>> responses(requests.size());
+    if(!this->multi) {
+        for(auto& response : responses) {
+            response = std::make_unique<quoneq_http_response>();
+            response->errorMessage = "Failed to initialize curl";
+        }
+
+        return responses;
+    }
+
+    std::vector<std::unique_ptr<transfer>> active;
+    size_t next = 0;
+
+    while(next < requests.size() || !active.empty()) {
+        while(next < requests.size() && active.size() < this->in_flight_limit) {
+            auto task = this->start(requests[next], next);
+            next++;
+
+            if(!task->curl)
+                responses[task->index] = std::move(task->response);
+            else active.push_back(std::move(task));
+        }
+
+        if(active.empty())
+            continue;
+
+        int running = 0;
+        curl_multi_perform(this->multi, &running);
+
+        CURLMsg* message = nullptr;
+        int queued = 0;
+
+        while((message = curl_multi_info_read(this->multi, &queued))) {
+            if(message->msg != CURLMSG_DONE)
+                continue;
+
+            void* task_ptr = nullptr;
+            curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &task_ptr);
+
+            transfer* task = static_cast<transfer*>(task_ptr);
+            this->finish(task, message->data.result);
+
+            for(auto it = active.begin(); it != active.end(); ++it)
+                if(it->get() == task) {
+                    responses[task->index] = std::move(task->response);
+                    active.erase(it);
+                    break;
+                }
+        }
+
+        if(running > 0)
+            curl_multi_poll(this->multi, nullptr, 0, 1000, nullptr);
+    }
+
+    return responses;
+}
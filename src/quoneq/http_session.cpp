@@ -0,0 +1,193 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/http_session.hpp>
+#include <quoneq/net.hpp>
+
+quoneq_http_session::quoneq_http_session(long max_connections) :
+    curl(curl_easy_init()),
+    connection_limit(max_connections),
+    requests(0),
+    reused(0),
+    policy() {
+    quoneq_net::persist_handle(this->curl);
+}
+
+quoneq_http_session::~quoneq_http_session() {
+    if(this->curl)
+        quoneq_net::cleanup_handle(this->curl);
+}
+
+void quoneq_http_session::prepare() {
+    curl_easy_reset(this->curl);
+
+    curl_easy_setopt(this->curl, CURLOPT_MAXCONNECTS, this->connection_limit);
+    curl_easy_setopt(this->curl, CURLOPT_TCP_KEEPALIVE, 1L);
+}
+
+void quoneq_http_session::track() {
+    long response_code = 0, new_connections = 0;
+
+    curl_easy_getinfo(this->curl, CURLINFO_RESPONSE_CODE, &response_code);
+    curl_easy_getinfo(this->curl, CURLINFO_NUM_CONNECTS, &new_connections);
+
+    this->requests++;
+    if(response_code != 0 && new_connections == 0)
+        this->reused++;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_session::get(
+    const std::string& url,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed
+) {
+    if(!this->curl)
+        return nullptr;
+
+    quoneq_http_request request;
+    request.url = url;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.policy = this->policy;
+    request.compressed = compressed;
+
+    this->prepare();
+    auto response = quoneq_http_client::perform(this->curl, request);
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_session::post(
+    const std::string& url,
+    const std::map<std::string, std::string>& form,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::map<std::string, std::string>& files,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    bool compressed
+) {
+    if(!this->curl)
+        return nullptr;
+
+    quoneq_http_request request;
+    request.method = "POST";
+    request.url = url;
+    request.form = form;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.files = files;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.policy = this->policy;
+    request.compressed = compressed;
+
+    this->prepare();
+    auto response = quoneq_http_client::perform(this->curl, request);
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_session::ping(
+    const std::string& url,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password
+) {
+    if(!this->curl)
+        return nullptr;
+
+    quoneq_http_request request;
+    request.method = "HEAD";
+    request.url = url;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+
+    this->prepare();
+    auto response = quoneq_http_client::perform_ping(this->curl, request);
+
+    this->track();
+    return response;
+}
+
+std::unique_ptr<quoneq_http_response> quoneq_http_session::download_file(
+    const std::string& url,
+    const std::string& out_filename,
+    const std::map<std::string, std::string>& form,
+    const std::map<std::string, std::string>& headers,
+    const std::map<std::string, std::string>& cookies,
+    const std::map<std::string, std::string>& files,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    const quoneq_file_sink_options& sink_options
+) {
+    if(!this->curl)
+        return nullptr;
+
+    quoneq_http_request request;
+    request.url = url;
+    request.form = form;
+    request.headers = headers;
+    request.cookies = cookies;
+    request.files = files;
+    request.proxy = proxy;
+    request.username = username;
+    request.password = password;
+    request.policy = this->policy;
+
+    this->prepare();
+    auto response = quoneq_http_client::perform_download_file(
+        this->curl,
+        request,
+        out_filename,
+        sink_options
+    );
+
+    this->track();
+    return response;
+}
+
+void quoneq_http_session::set_policy(const quoneq_http_policy& session_policy) {
+    this->policy = session_policy;
+}
+
+size_t quoneq_http_session::request_count() const {
+    return this->requests;
+}
+
+size_t quoneq_http_session::reused_connection_count() const {
+    return this->reused;
+}
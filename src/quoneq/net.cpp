@@ -21,34 +21,241 @@
  * THE SOFTWARE.
  */
 
+#include <quoneq/event_loop.hpp>
 #include <quoneq/net.hpp>
 
 #include <curl/curl.h>
+#include <fstream>
+#include <sstream>
 
 std::string quoneq_net::cacert_path = "";
+std::shared_ptr<const quoneq_net::ca_store> quoneq_net::cacert_store = nullptr;
+std::map<CURL*, quoneq_net::ca_binding> quoneq_net::ca_bindings = {};
+std::mutex quoneq_net::cacert_lock;
+
+CURLSH* quoneq_net::share = nullptr;
+std::mutex quoneq_net::share_locks[CURL_LOCK_DATA_LAST];
+
+void quoneq_net::share_lock(
+    CURL* handle,
+    curl_lock_data data,
+    curl_lock_access access,
+    void* userptr
+) {
+    (void) handle;
+    (void) access;
+    (void) userptr;
+
+    quoneq_net::share_locks[data].lock();
+}
+
+void quoneq_net::share_unlock(
+    CURL* handle,
+    curl_lock_data data,
+    void* userptr
+) {
+    (void) handle;
+    (void) userptr;
+
+    quoneq_net::share_locks[data].unlock();
+}
 
 void quoneq_net::init() {
     curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    if(quoneq_net::share)
+        return;
+
+    quoneq_net::share = curl_share_init();
+    if(!quoneq_net::share)
+        return;
+
+    curl_share_setopt(quoneq_net::share, CURLSHOPT_LOCKFUNC, quoneq_net::share_lock);
+    curl_share_setopt(quoneq_net::share, CURLSHOPT_UNLOCKFUNC, quoneq_net::share_unlock);
+    curl_share_setopt(quoneq_net::share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(quoneq_net::share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+    quoneq_net::load_ca_cert();
 }
 
 void quoneq_net::cleanup() {
+    quoneq_event_loop::stop();
+
+    if(quoneq_net::share) {
+        curl_share_cleanup(quoneq_net::share);
+        quoneq_net::share = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+
+        quoneq_net::cacert_store = nullptr;
+    }
+
     curl_global_cleanup();
 }
 
-void quoneq_net::set_ca_cert(std::string path) {
-    quoneq_net::cacert_path = path;
+void quoneq_net::attach_share(CURL* curl) {
+    if(quoneq_net::share)
+        curl_easy_setopt(curl, CURLOPT_SHARE, quoneq_net::share);
 }
 
-std::string quoneq_net::get_ca_cert() {
-    char* cacert = nullptr;
-    CURL *curl = curl_easy_init();
+/**
+ * @brief Tells whether the active TLS backend caches parsed CA files.
+ *
+ * CURLOPT_CA_CACHE_TIMEOUT is accepted by every backend but only honoured
+ * by OpenSSL and its forks, so the backend is read from the version info.
+ * Multi-SSL builds list the backends that are not selected in parentheses.
+ *
+ * @return True if CA files are parsed once per multi handle.
+ */
+static bool ca_cache_supported() {
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    if(!info || !info->ssl_version || info->version_num < 0x075700)
+        return false;
+
+    std::istringstream backends(info->ssl_version);
+    std::string backend;
+
+    while(backends >> backend) {
+        if(backend.front() == '(')
+            continue;
+
+        return backend.rfind("OpenSSL/", 0) == 0 ||
+            backend.rfind("LibreSSL/", 0) == 0 ||
+            backend.rfind("BoringSSL", 0) == 0 ||
+            backend.rfind("quictls/", 0) == 0;
+    }
+
+    return false;
+}
+
+void quoneq_net::load_ca_cert() {
+    auto store = std::make_shared<ca_store>();
+    {
+        std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+        store->path = quoneq_net::cacert_path;
+    }
+
+    CURL* curl = curl_easy_init();
+    if(curl) {
+#if LIBCURL_VERSION_NUM >= 0x075400
+        char* cacert = nullptr;
+        curl_easy_getinfo(curl, CURLINFO_CAINFO, &cacert);
+
+        if(store->path.empty() && cacert != nullptr && cacert[0] != '\0')
+            store->path = cacert;
+#endif
+
+        store->cached = ca_cache_supported();
 
+#if LIBCURL_VERSION_NUM >= 0x074D00
+        struct curl_blob probe = {nullptr, 0, CURL_BLOB_NOCOPY};
+        bool blob_supported = curl_easy_setopt(
+            curl,
+            CURLOPT_CAINFO_BLOB,
+            &probe
+        ) == CURLE_OK;
+
+        if(blob_supported && !store->path.empty()) {
+            std::ifstream file(store->path, std::ios::binary);
+            if(file) {
+                std::ostringstream pem;
+                pem << file.rdbuf();
+                store->pem = pem.str();
+            }
+        }
+#endif
+
+        curl_easy_cleanup(curl);
+    }
+
+    std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+    quoneq_net::cacert_store = store;
+}
+
+void quoneq_net::apply_ca_cert(CURL* curl) {
+    std::shared_ptr<const ca_store> store;
+    bool persistent = false;
+    {
+        std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+        store = quoneq_net::cacert_store;
+
+        auto bound = quoneq_net::ca_bindings.find(curl);
+        persistent = bound != quoneq_net::ca_bindings.end() && bound->second.persistent;
+    }
+
+    if(!store)
+        return;
+
+#if LIBCURL_VERSION_NUM >= 0x075700
+    // The CA cache lives in the (multi) handle, so only a handle performing
+    // many transfers gains from it; a one-shot handle would parse the file
+    // from disk all the same.
+    if(persistent && store->cached && !store->path.empty()) {
+        curl_easy_setopt(curl, CURLOPT_CAINFO, store->path.c_str());
+        curl_easy_setopt(curl, CURLOPT_CA_CACHE_TIMEOUT, 86400L);
+        return;
+    }
+#endif
+
+#if LIBCURL_VERSION_NUM >= 0x074D00
+    if(!store->pem.empty()) {
+        struct curl_blob blob = {
+            const_cast<char*>(store->pem.data()),
+            store->pem.size(),
+            CURL_BLOB_NOCOPY
+        };
+
+        if(curl_easy_setopt(curl, CURLOPT_CAINFO_BLOB, &blob) == CURLE_OK) {
+            std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+            quoneq_net::ca_bindings[curl].store = store;
+
+            return;
+        }
+    }
+#endif
+
+    if(!store->path.empty())
+        curl_easy_setopt(curl, CURLOPT_CAINFO, store->path.c_str());
+}
+
+void quoneq_net::persist_handle(CURL* curl) {
     if(!curl)
-        return quoneq_net::cacert_path;
+        return;
+
+    std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+    quoneq_net::ca_bindings[curl].persistent = true;
+}
+
+void quoneq_net::cleanup_handle(CURL* curl) {
+    if(!curl)
+        return;
+
+    curl_easy_cleanup(curl);
+
+    std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+    quoneq_net::ca_bindings.erase(curl);
+}
+
+void quoneq_net::set_ca_cert(std::string path) {
+    bool initialized = false;
+    {
+        std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
+
+        quoneq_net::cacert_path = path;
+        initialized = quoneq_net::cacert_store != nullptr;
+    }
+
+    if(initialized)
+        quoneq_net::load_ca_cert();
+}
+
+std::string quoneq_net::get_ca_cert() {
+    std::lock_guard<std::mutex> lock(quoneq_net::cacert_lock);
 
-    curl_easy_getinfo(curl, CURLINFO_CAINFO, &cacert);
-    if((cacert != NULL) && (cacert[0] == '\0'))
-        return std::string(cacert);
+    if(quoneq_net::cacert_store)
+        return quoneq_net::cacert_store->path;
 
-    return quoneq_net::cacert_path; 
+    return quoneq_net::cacert_path;
 }
@@ -21,6 +21,8 @@
  * THE SOFTWARE.
  */
 
+#include <quoneq/event_loop.hpp>
+#include <quoneq/net.hpp>
 #include <quoneq/smtp.hpp>
 
 #include <cstring>
@@ -53,7 +55,7 @@ size_t quoneq_smtp_client::payload_source(
     return 0;
 }
 
-void quoneq_smtp_client::setup_mime_structure(
+curl_mime* quoneq_smtp_client::setup_mime_structure(
     CURL* curl,
     const std::string& email,
     const std::string& recipient,
@@ -99,9 +101,11 @@ void quoneq_smtp_client::setup_mime_structure(
     }
 
     curl_easy_setopt(curl, CURLOPT_MIMEPOST, mime);
+    return mime;
 }
 
-bool quoneq_smtp_client::send_email(
+void quoneq_smtp_client::prepare_email(
+    CURL* curl,
     const std::string& smtp_server,
     const std::string& email,
     const std::string& password,
@@ -109,29 +113,26 @@ bool quoneq_smtp_client::send_email(
     const std::string& subject,
     const std::string& message,
     bool is_html,
-    const std::vector<std::string>& files
+    const std::vector<std::string>& files,
+    upload_context* upload,
+    struct curl_slist** recipients,
+    curl_mime** mime
 ) {
-    CURL* curl = curl_easy_init();
-    if(!curl)
-        return false;
-
-    struct curl_slist* recipients = NULL;
-    upload_context upload_ctx{0, ""};
-
     curl_easy_setopt(curl, CURLOPT_URL, smtp_server.c_str());
-    curl_easy_setopt(curl, CURLOPT_CAINFO, "C:\\Windows\\System32\\cacert.pem");
+    quoneq_net::attach_share(curl);
+    quoneq_net::apply_ca_cert(curl);
     curl_easy_setopt(curl, CURLOPT_USERNAME, email.c_str());
     curl_easy_setopt(curl, CURLOPT_PASSWORD, password.c_str());
     curl_easy_setopt(curl, CURLOPT_MAIL_FROM, email.c_str());
     
-    recipients = curl_slist_append(recipients, recipient.c_str());
-    curl_easy_setopt(curl, CURLOPT_MAIL_RCPT, recipients);
+    *recipients = curl_slist_append(*recipients, recipient.c_str());
+    curl_easy_setopt(curl, CURLOPT_MAIL_RCPT, *recipients);
     curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
 
     if(files.empty()) {
-        upload_ctx.payload = 
+        upload->payload = 
             "From: " + email + "\r\n"
             "To: " + recipient + "\r\n"
             "Subject: " + subject + "\r\n"
@@ -141,10 +142,10 @@ bool quoneq_smtp_client::send_email(
             message + "\r\n";
 
         curl_easy_setopt(curl, CURLOPT_READFUNCTION, payload_source);
-        curl_easy_setopt(curl, CURLOPT_READDATA, &upload_ctx);
+        curl_easy_setopt(curl, CURLOPT_READDATA, upload);
         curl_easy_setopt(curl, CURLOPT_UPLOAD, 1L);
     }
-    else setup_mime_structure(
+    else *mime = setup_mime_structure(
         curl,
         email,
         recipient,
@@ -153,16 +154,96 @@ bool quoneq_smtp_client::send_email(
         is_html,
         files
     );
+}
+
+bool quoneq_smtp_client::send_email(
+    const std::string& smtp_server,
+    const std::string& email,
+    const std::string& password,
+    const std::string& recipient,
+    const std::string& subject,
+    const std::string& message,
+    bool is_html,
+    const std::vector<std::string>& files
+) {
+    CURL* curl = curl_easy_init();
+    if(!curl)
+        return false;
+
+    struct curl_slist* recipients = NULL;
+    curl_mime* mime = NULL;
+    upload_context upload_ctx{0, ""};
+
+    quoneq_smtp_client::prepare_email(
+        curl,
+        smtp_server,
+        email,
+        password,
+        recipient,
+        subject,
+        message,
+        is_html,
+        files,
+        &upload_ctx,
+        &recipients,
+        &mime
+    );
 
     CURLcode res = curl_easy_perform(curl);
     bool success = (res == CURLE_OK);
 
     curl_slist_free_all(recipients);
-    curl_easy_cleanup(curl);
+    quoneq_net::cleanup_handle(curl);
+    curl_mime_free(mime);
 
     return success;
 }
 
+std::future<bool> quoneq_smtp_client::send_email_async(
+    const std::string& smtp_server,
+    const std::string& email,
+    const std::string& password,
+    const std::string& recipient,
+    const std::string& subject,
+    const std::string& message,
+    bool is_html,
+    const std::vector<std::string>& files
+) {
+    auto task = std::make_shared<async_email>();
+    auto future = task->promise.get_future();
+
+    task->curl = curl_easy_init();
+    if(!task->curl) {
+        task->promise.set_value(false);
+        return future;
+    }
+
+    quoneq_smtp_client::prepare_email(
+        task->curl,
+        smtp_server,
+        email,
+        password,
+        recipient,
+        subject,
+        message,
+        is_html,
+        files,
+        &task->upload,
+        &task->recipients,
+        &task->mime
+    );
+
+    quoneq_event_loop::submit(task->curl, [task](CURLcode result) {
+        curl_slist_free_all(task->recipients);
+        quoneq_net::cleanup_handle(task->curl);
+        curl_mime_free(task->mime);
+
+        task->promise.set_value(result == CURLE_OK);
+    });
+
+    return future;
+}
+
 bool quoneq_smtp_client::send_mail(
     const std::string& smtp_server,
     const std::string& email,
@@ -54,6 +54,7 @@ std::unique_ptr<quoneq_telnet_response> quoneq_telnet_client::command(
     std::string response_string;
 
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    quoneq_net::attach_share(curl);
     curl_easy_setopt(
         curl,
         CURLOPT_WRITEFUNCTION,
@@ -63,11 +64,7 @@ std::unique_ptr<quoneq_telnet_response> quoneq_telnet_client::command(
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_string);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout);
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, timeout);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
-    );
+    quoneq_net::apply_ca_cert(curl);
 
     if(!proxy.empty())
         curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
@@ -97,6 +94,29 @@ std::unique_ptr<quoneq_telnet_response> quoneq_telnet_client::command(
     return response;
 }
 
+std::future<std::unique_ptr<quoneq_telnet_response>> quoneq_telnet_client::command_async(
+    const std::string& url,
+    const std::vector<std::string>& commands,
+    const std::string& proxy,
+    const std::string& username,
+    const std::string& password,
+    long timeout
+) {
+    return std::async(
+        std::launch::async,
+        [url, commands, proxy, username, password, timeout]() {
+            return quoneq_telnet_client::command(
+                url,
+                commands,
+                proxy,
+                username,
+                password,
+                timeout
+            );
+        }
+    );
+}
+
 std::unique_ptr<quoneq_telnet_response> quoneq_telnet_client::connect(
     const std::string& url,
     const std::string& proxy,
@@ -185,6 +205,7 @@ std::unique_ptr<quoneq_telnet_response> quoneq_telnet_client::exec_with_options(
     std::string response_string;
 
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    quoneq_net::attach_share(curl);
     curl_easy_setopt(
         curl,
         CURLOPT_WRITEFUNCTION,
@@ -194,11 +215,7 @@ std::unique_ptr<quoneq_telnet_response> quoneq_telnet_client::exec_with_options(
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_string);
     curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout);
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, timeout);
-    curl_easy_setopt(
-        curl,
-        CURLOPT_CAINFO,
-        quoneq_net::get_ca_cert().c_str()
-    );
+    quoneq_net::apply_ca_cert(curl);
 
     if(!proxy.empty())
         curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
@@ -28,7 +28,8 @@ std::unique_ptr<quoneq_http_response> quoneq_tor_client::get(
     const std::map<std::string, std::string>& headers,
     const std::map<std::string, std::string>& cookies,
     const std::string& username,
-    const std::string& password
+    const std::string& password,
+    bool compressed
 ) {
     return quoneq_http_client::get(
         url,
@@ -36,7 +37,8 @@ std::unique_ptr<quoneq_http_response> quoneq_tor_client::get(
         cookies,
         "socks5h://localhost:9050",
         username,
-        password
+        password,
+        compressed
     );
 }
 
@@ -47,7 +49,8 @@ std::unique_ptr<quoneq_http_response> quoneq_tor_client::post(
     const std::map<std::string, std::string>& cookies,
     const std::map<std::string, std::string>& files,
     const std::string& username,
-    const std::string& password
+    const std::string& password,
+    bool compressed
 ) {
     return quoneq_http_client::post(
         url,
@@ -57,7 +60,8 @@ std::unique_ptr<quoneq_http_response> quoneq_tor_client::post(
         files,
         "socks5h://localhost:9050",
         username,
-        password
+        password,
+        compressed
     );
 }
 
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the Quoneq library.
+ * Copyright (c) 2025 Nathanne Isip
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <quoneq/upload_source.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+quoneq_upload_source::quoneq_upload_source(const std::string& path) :
+    base(nullptr),
+    length(0),
+    position(0),
+    mapping(nullptr),
+    valid(false) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return;
+    }
+
+    this->length = static_cast<size_t>(info.st_size);
+    if(this->length > 0) {
+        void* data = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if(data == MAP_FAILED) {
+            ::close(fd);
+            return;
+        }
+
+        madvise(data, this->length, MADV_SEQUENTIAL);
+        this->mapping = data;
+        this->base = static_cast<const std::byte*>(data);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+    this->valid = true;
+}
+
+quoneq_upload_source::quoneq_upload_source(std::span<const std::byte> data) :
+    base(data.data()),
+    length(data.size()),
+    position(0),
+    mapping(nullptr),
+    valid(true) { }
+
+quoneq_upload_source::~quoneq_upload_source() {
+    if(this->mapping)
+        munmap(this->mapping, this->length);
+}
+
+bool quoneq_upload_source::is_open() const {
+    return this->valid;
+}
+
+size_t quoneq_upload_source::size() const {
+    return this->length;
+}
+
+size_t quoneq_upload_source::read(char* buffer, size_t capacity) {
+    size_t count = std::min(capacity, this->length - this->position);
+    if(count == 0)
+        return 0;
+
+    std::memcpy(buffer, this->base + this->position, count);
+    this->position += count;
+
+    return count;
+}
+
+bool quoneq_upload_source::seek(size_t offset) {
+    if(offset > this->length)
+        return false;
+
+    this->position = offset;
+    return true;
+}
@@ -40,11 +40,18 @@ mkdir -p "${INCLUDE_DIR}/quoneq"
 mkdir -p "${USR_DIR}/lib/${LIB_DIR}"
 mkdir -p "${BUILD_DIR}"
 
+# zstd request bodies are opt-in: only enabled when libzstd is installed
+ZSTD_FLAGS=""
+if [ "$ARCHITECTURE" = "amd64" ] && pkg-config --exists libzstd 2>/dev/null; then
+    ZSTD_FLAGS="-DQUONEQ_USE_ZSTD $(pkg-config --libs libzstd)"
+    echo -e "\033[92m[+]\033[0m libzstd found, enabling zstd request bodies."
+fi
+
 echo -e "\033[92m[+]\033[0m Building shared library for ${ARCHITECTURE}..."
 if [ "$ARCHITECTURE" = "amd64" ]; then
-    g++ -fPIC -shared -o "${SO_FILE}" -Iinclude src/quoneq/*.cpp
+    g++ -std=c++23 -fPIC -shared -o "${SO_FILE}" -Iinclude src/quoneq/*.cpp ${ZSTD_FLAGS} -lz -lcurl
 else
-    ${CROSS_COMPILE}g++ -fPIC -shared -o "${SO_FILE}" -Iinclude src/quoneq/*.cpp
+    ${CROSS_COMPILE}g++ -std=c++23 -fPIC -shared -o "${SO_FILE}" -Iinclude src/quoneq/*.cpp -lz -lcurl
 fi
 
 cp -r include/quoneq/* "${INCLUDE_DIR}/quoneq/"